@@ -0,0 +1,282 @@
+#include "procmine/algorithm.h"
+#include "procmine/export.h"
+#include "procmine/log.h"
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+using namespace procmine;
+
+namespace {
+
+const std::vector<std::vector<std::string>> variants = {
+    {"register", "check", "approve", "notify", "archive"},
+    {"register", "approve", "check", "notify", "archive"},
+    {"register", "check", "reject", "notify", "archive"},
+    {"register", "check", "request info", "check", "approve", "notify", "archive"},
+    {"register", "check", "approve", "pay", "notify", "archive"},
+    {"register", "escalate", "check", "approve", "notify", "archive"}
+};
+
+std::shared_ptr<EventLog> generate_log(size_t events) {
+    auto log = std::make_shared<EventLog>();
+    std::mt19937_64 random(events);
+    std::discrete_distribution<size_t> pick({40, 20, 15, 10, 10, 5});
+    std::uniform_int_distribution<int> delay(30, 3600);
+    std::uniform_int_distribution<int> staff(1, 40);
+    auto clock = std::chrono::system_clock::from_time_t(1704067200);
+
+    size_t produced = 0;
+    for (size_t case_number = 0; produced < events; ++case_number) {
+        const auto& activities = variants[pick(random)];
+        Trace trace("case" + std::to_string(case_number));
+        auto time = clock + std::chrono::seconds(case_number * 60);
+        for (size_t i = 0; i < activities.size() && produced < events; ++i, ++produced) {
+            time += std::chrono::seconds(delay(random));
+            Event event;
+            event.activity = activities[i];
+            event.resource = "user" + std::to_string(staff(random));
+            event.timestamp = time;
+            trace.add_event(event);
+        }
+        log->add_trace(trace);
+    }
+    return log;
+}
+
+std::shared_ptr<EventLog> cached_log(size_t events) {
+    static std::map<size_t, std::shared_ptr<EventLog>> logs;
+    auto& log = logs[events];
+    if (!log) {
+        log = generate_log(events);
+    }
+    return log;
+}
+
+class RunDirectory {
+public:
+    RunDirectory()
+        : path_(std::filesystem::temp_directory_path() /
+                ("procmine_bench_" + std::to_string(::getpid()))) {
+        std::filesystem::remove_all(path_);
+        std::filesystem::create_directories(path_);
+    }
+
+    ~RunDirectory() {
+        std::error_code error;
+        std::filesystem::remove_all(path_, error);
+    }
+
+    const std::filesystem::path& path() const { return path_; }
+
+private:
+    std::filesystem::path path_;
+};
+
+std::string bench_path(const std::string& name, size_t events) {
+    static RunDirectory directory;
+    return (directory.path() / (std::to_string(events) + "_" + name)).string();
+}
+
+std::string cached_csv(size_t events) {
+    std::string path = bench_path("log.csv", events);
+    if (!std::filesystem::exists(path)) {
+        CSVLogWriter(path).write(*cached_log(events));
+    }
+    return path;
+}
+
+std::string cached_sqlite(size_t events) {
+    std::string path = bench_path("log.db", events);
+    if (!std::filesystem::exists(path)) {
+        SQLiteLogWriter writer(path, "events");
+        writer.set_bulk_mode(true);
+        writer.write(*cached_log(events));
+    }
+    return path;
+}
+
+long status_kb(const std::string& field) {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, field.size(), field) == 0) {
+            return std::strtol(line.c_str() + field.size(), nullptr, 10);
+        }
+    }
+    return -1;
+}
+
+class MemoryProbe {
+public:
+    MemoryProbe() {
+#ifdef __GLIBC__
+        ::malloc_trim(0);
+#endif
+        std::ofstream clear_refs("/proc/self/clear_refs");
+        clear_refs << "5";
+        clear_refs.flush();
+        reset_ = static_cast<bool>(clear_refs);
+        baseline_kb_ = status_kb("VmRSS:");
+    }
+
+    void report(benchmark::State& state) const {
+        long peak_kb = status_kb("VmHWM:");
+        if (!reset_ || peak_kb < 0 || baseline_kb_ < 0) {
+            return;
+        }
+        state.counters["peak_rss_mb"] = static_cast<double>(peak_kb) / 1024.0;
+        state.counters["rss_delta_mb"] = static_cast<double>(peak_kb - baseline_kb_) / 1024.0;
+    }
+
+private:
+    bool reset_;
+    long baseline_kb_;
+};
+
+void report(benchmark::State& state, size_t events, const MemoryProbe& memory) {
+    state.counters["events_per_second"] = benchmark::Counter(
+        static_cast<double>(events) * static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+    memory.report(state);
+}
+
+void BM_CSVRead(benchmark::State& state) {
+    const size_t events = static_cast<size_t>(state.range(0));
+    std::string path = cached_csv(events);
+    MemoryProbe memory;
+    for (auto _ : state) {
+        CSVLogReader reader(path);
+        benchmark::DoNotOptimize(reader.read());
+    }
+    report(state, events, memory);
+}
+
+void BM_SQLiteRead(benchmark::State& state) {
+    const size_t events = static_cast<size_t>(state.range(0));
+    std::string path = cached_sqlite(events);
+    MemoryProbe memory;
+    for (auto _ : state) {
+        SQLiteLogReader reader(path, "SELECT * FROM events");
+        benchmark::DoNotOptimize(reader.read());
+    }
+    report(state, events, memory);
+}
+
+void BM_AlphaMine(benchmark::State& state) {
+    const size_t events = static_cast<size_t>(state.range(0));
+    auto log = cached_log(events);
+    AlphaAlgorithm miner;
+    MemoryProbe memory;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(miner.mine(*log));
+    }
+    report(state, events, memory);
+}
+
+void BM_HeuristicMine(benchmark::State& state) {
+    const size_t events = static_cast<size_t>(state.range(0));
+    auto log = cached_log(events);
+    HeuristicMiner miner;
+    MemoryProbe memory;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(miner.mine(*log));
+    }
+    report(state, events, memory);
+}
+
+void BM_InductiveMine(benchmark::State& state) {
+    const size_t events = static_cast<size_t>(state.range(0));
+    auto log = cached_log(events);
+    InductiveMiner miner;
+    MemoryProbe memory;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(miner.mine_tree(*log));
+    }
+    report(state, events, memory);
+}
+
+void BM_FrequencyAnalyze(benchmark::State& state) {
+    const size_t events = static_cast<size_t>(state.range(0));
+    auto log = cached_log(events);
+    FrequencyAnalyzer analyzer;
+    MemoryProbe memory;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(analyzer.analyze(*log));
+    }
+    report(state, events, memory);
+}
+
+void BM_Conformance(benchmark::State& state) {
+    const size_t events = static_cast<size_t>(state.range(0));
+    auto model = AlphaAlgorithm().mine(*generate_log(10000));
+    auto log = cached_log(events);
+    ConformanceChecker checker(*model);
+    MemoryProbe memory;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(checker.calculate_overall_conformance(*log));
+    }
+    report(state, events, memory);
+}
+
+void BM_CSVWrite(benchmark::State& state) {
+    const size_t events = static_cast<size_t>(state.range(0));
+    auto log = cached_log(events);
+    std::string path = bench_path("write.csv", events);
+    MemoryProbe memory;
+    for (auto _ : state) {
+        CSVLogWriter(path).write(*log);
+    }
+    std::remove(path.c_str());
+    report(state, events, memory);
+}
+
+void BM_GraphExport(benchmark::State& state) {
+    const size_t events = static_cast<size_t>(state.range(0));
+    auto log = cached_log(events);
+    FrequencyAnalyzer analyzer;
+    auto graph = analyzer.build_process_graph(analyzer.analyze(*log));
+    MemoryProbe memory;
+    for (auto _ : state) {
+        std::ostringstream dot;
+        DOTGraphWriter(dot).write(*graph);
+        std::ostringstream binary;
+        BinaryGraphWriter(binary).write(*graph);
+        benchmark::DoNotOptimize(dot.str().size() + binary.str().size());
+    }
+    report(state, events, memory);
+}
+
+void scales(benchmark::internal::Benchmark* benchmark) {
+    benchmark->Arg(10000)->Arg(1000000);
+    const char* large = std::getenv("PROCMINE_BENCH_LARGE");
+    if (large && std::string(large) == "1") {
+        benchmark->Arg(10000000);
+    }
+    benchmark->Unit(benchmark::kMillisecond)->UseRealTime();
+}
+
+}
+
+BENCHMARK(BM_CSVRead)->Apply(scales);
+BENCHMARK(BM_SQLiteRead)->Apply(scales);
+BENCHMARK(BM_AlphaMine)->Apply(scales);
+BENCHMARK(BM_HeuristicMine)->Apply(scales);
+BENCHMARK(BM_InductiveMine)->Apply(scales);
+BENCHMARK(BM_FrequencyAnalyze)->Apply(scales);
+BENCHMARK(BM_Conformance)->Apply(scales);
+BENCHMARK(BM_CSVWrite)->Apply(scales);
+BENCHMARK(BM_GraphExport)->Apply(scales);
+
+BENCHMARK_MAIN();
@@ -1,8 +1,15 @@
 #pragma once
 
 #include "procmine/models.h"
+#include "procmine/sketch.h"
+#include "procmine/summary.h"
+#include <cstdint>
+#include <functional>
+#include <iterator>
 #include <memory>
+#include <span>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -31,14 +38,74 @@ using ProcessModelGraph = boost::adjacency_list<
 using Vertex = boost::graph_traits<ProcessModelGraph>::vertex_descriptor;
 using Edge = boost::graph_traits<ProcessModelGraph>::edge_descriptor;
 
+class FrozenProcessGraph;
+
 class ProcessGraph {
 public:
+    static constexpr Vertex npos = static_cast<Vertex>(-1);
+
+    struct EdgeRef {
+        Vertex from;
+        Vertex to;
+        double weight;
+    };
+
+    class OutEdgeRange {
+    public:
+        using base_iterator = boost::graph_traits<ProcessModelGraph>::out_edge_iterator;
+
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = EdgeRef;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = EdgeRef;
+
+            iterator(const ProcessModelGraph* graph, base_iterator it) : graph_(graph), it_(it) {}
+
+            EdgeRef operator*() const {
+                return {boost::source(*it_, *graph_), boost::target(*it_, *graph_), (*graph_)[*it_].weight};
+            }
+            iterator& operator++() { ++it_; return *this; }
+            iterator operator++(int) { iterator copy = *this; ++it_; return copy; }
+            bool operator==(const iterator& other) const { return it_ == other.it_; }
+            bool operator!=(const iterator& other) const { return it_ != other.it_; }
+
+        private:
+            const ProcessModelGraph* graph_;
+            base_iterator it_;
+        };
+
+        OutEdgeRange(const ProcessModelGraph* graph, base_iterator first, base_iterator last)
+            : graph_(graph), first_(first), last_(last) {}
+
+        iterator begin() const { return iterator(graph_, first_); }
+        iterator end() const { return iterator(graph_, last_); }
+        size_t size() const { return static_cast<size_t>(std::distance(first_, last_)); }
+        bool empty() const { return first_ == last_; }
+
+    private:
+        const ProcessModelGraph* graph_;
+        base_iterator first_;
+        base_iterator last_;
+    };
+
     ProcessGraph();
     
     Vertex add_node(const std::string& activity);
     
     Edge add_edge(const Vertex& from, const Vertex& to, double weight = 1.0);
     Edge add_edge(const std::string& from, const std::string& to, double weight = 1.0);
+
+    size_t node_count() const;
+    Vertex find_node(std::string_view activity) const;
+    std::string_view get_name(Vertex node) const;
+    OutEdgeRange out_edges(Vertex node) const;
+
+    bool has_edge(Vertex from, Vertex to) const;
+    bool has_edge(std::string_view from, std::string_view to) const;
+    bool find_edge(Vertex from, Vertex to, double& weight) const;
     
     std::vector<std::string> get_nodes() const;
     
@@ -53,36 +120,198 @@ public:
     std::string to_dot() const;
 
     const ProcessModelGraph& get_graph() const { return graph_; }
+
+    std::shared_ptr<const FrozenProcessGraph> freeze() const;
     
 private:
+    struct NameHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view name) const { return std::hash<std::string_view>{}(name); }
+    };
+
+    static uint64_t edge_key(Vertex from, Vertex to);
+
     ProcessModelGraph graph_;
-    std::unordered_map<std::string, Vertex> activity_to_vertex_;
-    std::unordered_map<Vertex, std::string> vertex_to_activity_;
+    std::unordered_map<std::string, Vertex, NameHash, std::equal_to<>> activity_to_vertex_;
+    std::unordered_map<uint64_t, double> edge_weights_;
+};
+
+class FrozenProcessGraph {
+public:
+    static constexpr uint32_t npos = UINT32_MAX;
+
+    FrozenProcessGraph(const ProcessGraph& graph);
+
+    size_t node_count() const;
+    size_t edge_count() const;
+
+    uint32_t find_node(std::string_view activity) const;
+    std::string_view get_name(uint32_t node) const;
+
+    std::span<const uint32_t> out_targets(uint32_t node) const;
+    std::span<const double> out_weights(uint32_t node) const;
+
+    bool has_edge(uint32_t from, uint32_t to) const;
+    bool find_edge(uint32_t from, uint32_t to, double& weight) const;
+
+    std::vector<std::string> get_nodes() const;
+    std::vector<ProcessGraph::EdgeInfo> get_outgoing_edges(const std::string& node) const;
+
+private:
+    uint32_t slot_for(std::string_view activity) const;
+
+    std::vector<uint32_t> offsets_;
+    std::vector<uint32_t> targets_;
+    std::vector<double> weights_;
+    std::string names_;
+    std::vector<uint32_t> name_offsets_;
+    uint64_t seed_;
+    std::vector<uint32_t> displacements_;
+    std::vector<uint32_t> slots_;
 };
 
 class MiningAlgorithm {
 public:
     virtual ~MiningAlgorithm() = default;
     virtual std::shared_ptr<ProcessGraph> mine(const EventLog& log) = 0;
+    virtual std::shared_ptr<ProcessGraph> mine(const LogView& view);
 };
 
 class AlphaAlgorithm : public MiningAlgorithm {
 public:
+    using MiningAlgorithm::mine;
+
     AlphaAlgorithm();
     std::shared_ptr<ProcessGraph> mine(const EventLog& log) override;
+    std::shared_ptr<ProcessGraph> mine(const LogView& view) override;
 };
 
 class HeuristicMiner : public MiningAlgorithm {
 public:
+    using MiningAlgorithm::mine;
+
     HeuristicMiner(double dependency_threshold = 0.9, 
                   double positive_observations_threshold = 1.0);
     std::shared_ptr<ProcessGraph> mine(const EventLog& log) override;
+    std::shared_ptr<ProcessGraph> mine(const LogView& view) override;
+    std::shared_ptr<ProcessGraph> mine(const MiningSummary& summary);
     
 private:
+    std::shared_ptr<ProcessGraph> build_graph(
+        std::vector<std::string> activities,
+        const std::unordered_map<std::string, std::unordered_map<std::string, uint64_t>>& transitions) const;
+
     double dependency_threshold_;
     double positive_observations_threshold_;
 };
 
+class ProcessTree {
+public:
+    enum class Operator {
+        Activity,
+        Tau,
+        Sequence,
+        Exclusive,
+        Parallel,
+        Loop
+    };
+
+    ProcessTree(Operator op, const std::string& label = "");
+
+    static std::shared_ptr<ProcessTree> activity(const std::string& label);
+    static std::shared_ptr<ProcessTree> tau();
+
+    void add_child(std::shared_ptr<ProcessTree> child);
+
+    Operator get_operator() const;
+    const std::string& get_label() const;
+    const std::vector<std::shared_ptr<ProcessTree>>& get_children() const;
+
+    std::string to_string() const;
+    std::shared_ptr<ProcessGraph> to_process_graph() const;
+
+private:
+    Operator operator_;
+    std::string label_;
+    std::vector<std::shared_ptr<ProcessTree>> children_;
+};
+
+class InductiveMiner : public MiningAlgorithm {
+public:
+    using MiningAlgorithm::mine;
+
+    InductiveMiner();
+    std::shared_ptr<ProcessGraph> mine(const EventLog& log) override;
+    std::shared_ptr<ProcessGraph> mine(const LogView& view) override;
+
+    std::shared_ptr<ProcessTree> mine_tree(const EventLog& log);
+    std::shared_ptr<ProcessTree> mine_tree(const LogView& view);
+
+    void set_parallelism(unsigned threads);
+
+private:
+    unsigned parallelism_;
+};
+
+class TransitionSketch {
+public:
+    TransitionSketch(double epsilon = 0.001, double delta = 0.01, size_t heavy_hitters = 64);
+
+    void add(const std::string& from, const std::string& to, uint64_t count = 1);
+    uint64_t estimate(const std::string& from, const std::string& to) const;
+    void merge(const TransitionSketch& other);
+
+    std::vector<ProcessGraph::EdgeInfo> top_transitions() const;
+
+    uint64_t total() const;
+    double error_bound() const;
+    size_t memory_usage() const;
+
+private:
+    struct HeavyHitter {
+        std::string from;
+        std::string to;
+        uint64_t count;
+    };
+
+    static uint64_t pair_key(const std::string& from, const std::string& to);
+    void offer(uint64_t key, const std::string& from, const std::string& to, uint64_t count);
+
+    CountMinSketch counts_;
+    size_t capacity_;
+    std::unordered_map<uint64_t, HeavyHitter> heavy_hitters_;
+    uint64_t minimum_;
+};
+
+class VariantTracker {
+public:
+    VariantTracker(size_t capacity = 1000);
+
+    struct VariantEstimate {
+        std::vector<std::string> activities;
+        uint64_t count;
+        uint64_t error;
+    };
+
+    void add(const Trace& trace);
+    void add(const TraceView& trace);
+    void add(const std::vector<std::string>& activities, uint64_t count = 1);
+    void merge(const VariantTracker& other);
+
+    std::vector<VariantEstimate> top(size_t k) const;
+
+    uint64_t total() const;
+    uint64_t error_bound() const;
+    size_t memory_usage() const;
+
+private:
+    template <typename Sequence>
+    void add_sequence(const Sequence& events, uint64_t count);
+
+    SpaceSaving counters_;
+    std::unordered_map<uint64_t, std::vector<std::string>> sequences_;
+};
+
 class FrequencyAnalyzer {
 public:
     FrequencyAnalyzer();
@@ -95,14 +324,127 @@ public:
     };
     
     FrequencyMetrics analyze(const EventLog& log);
+    FrequencyMetrics analyze(const LogView& view);
+    FrequencyMetrics analyze(const MiningSummary& summary);
 
     std::shared_ptr<ProcessGraph> build_process_graph(const FrequencyMetrics& metrics,
                                                     double threshold = 0.0);
+
+    TransitionSketch sketch_transitions(const EventLog& log, double epsilon = 0.001,
+                                        double delta = 0.01, size_t heavy_hitters = 64);
+    TransitionSketch sketch_transitions(const LogView& view, double epsilon = 0.001,
+                                        double delta = 0.01, size_t heavy_hitters = 64);
+
+    std::shared_ptr<ProcessGraph> build_process_graph(const TransitionSketch& sketch,
+                                                    double threshold = 0.0);
+
+    VariantTracker track_variants(const EventLog& log, size_t capacity = 1000);
+    VariantTracker track_variants(const LogView& view, size_t capacity = 1000);
+};
+
+class PerformanceAnalyzer {
+public:
+    PerformanceAnalyzer(double compression = 100.0);
+
+    struct LatencyStatistics {
+        uint64_t count;
+        double mean;
+        double min;
+        double max;
+        double p50;
+        double p95;
+        double p99;
+    };
+
+    struct PerformanceMetrics {
+        std::unordered_map<std::string, TDigest> sojourn_time;
+        std::unordered_map<std::string, std::unordered_map<std::string, TDigest>> transition_time;
+    };
+
+    PerformanceMetrics analyze(const EventLog& log);
+    PerformanceMetrics analyze(const LogView& view);
+
+    static LatencyStatistics summarize(const TDigest& digest);
+
+    std::shared_ptr<ProcessGraph> build_process_graph(const PerformanceMetrics& metrics,
+                                                    double quantile = 0.5);
+
+    void set_parallelism(unsigned threads);
+
+private:
+    double compression_;
+    unsigned parallelism_;
+};
+
+class CardinalityAnalyzer {
+public:
+    CardinalityAnalyzer(unsigned precision = 12);
+
+    struct CardinalityMetrics {
+        std::unordered_map<std::string, HyperLogLog> activity_cases;
+        std::unordered_map<std::string, HyperLogLog> activity_resources;
+        std::unordered_map<std::string, std::unordered_map<std::string, HyperLogLog>> transition_cases;
+        std::unordered_map<std::string, std::unordered_map<std::string, HyperLogLog>> transition_resources;
+    };
+
+    CardinalityMetrics analyze(const EventLog& log);
+    CardinalityMetrics analyze(const LogView& view);
+
+    void merge(CardinalityMetrics& target, const CardinalityMetrics& source) const;
+
+    void set_parallelism(unsigned threads);
+
+private:
+    unsigned precision_;
+    unsigned parallelism_;
+};
+
+enum class EdgeMetric {
+    Frequency,
+    Significance
+};
+
+class DFGSimplifier {
+public:
+    DFGSimplifier(const ProcessGraph& graph, EdgeMetric metric = EdgeMetric::Frequency);
+
+    void set_edge_percentage(double fraction);
+    void set_node_threshold(double threshold);
+    void set_start_activities(const std::vector<std::string>& activities);
+    void set_end_activities(const std::vector<std::string>& activities);
+
+    std::shared_ptr<ProcessGraph> simplify() const;
+
+private:
+    struct RankedEdge {
+        Vertex from;
+        Vertex to;
+        double weight;
+        double score;
+    };
+
+    void compute_widest_paths();
+    void widest_paths(const std::vector<uint8_t>& roots, bool forward, std::vector<uint32_t>& parents) const;
+
+    std::vector<std::string> names_;
+    std::unordered_map<std::string, Vertex> index_;
+    std::vector<RankedEdge> edges_;
+    std::vector<uint32_t> ranked_;
+    std::vector<std::vector<uint32_t>> outgoing_;
+    std::vector<std::vector<uint32_t>> incoming_;
+    std::vector<double> node_significance_;
+    std::vector<uint8_t> is_start_;
+    std::vector<uint8_t> is_end_;
+    std::vector<uint32_t> start_parents_;
+    std::vector<uint32_t> end_parents_;
+    double edge_percentage_;
+    double node_threshold_;
 };
 
 class ConformanceChecker {
 public:
     ConformanceChecker(const ProcessGraph& process_model);
+    ConformanceChecker(const FrozenProcessGraph& process_model);
 
     struct ConformanceResult {
         double fitness;
@@ -112,13 +454,20 @@ public:
     };
     
     ConformanceResult check_trace(const Trace& trace);
+    ConformanceResult check_trace(const TraceView& trace);
 
     std::vector<ConformanceResult> check_log(const EventLog& log);
+    std::vector<ConformanceResult> check_log(const LogView& view);
 
     double calculate_overall_conformance(const EventLog& log);
+    double calculate_overall_conformance(const LogView& view);
     
 private:
-    const ProcessGraph& process_model_;
+    bool has_transition(const std::string& from, const std::string& to) const;
+    bool has_activity(const std::string& activity) const;
+
+    const ProcessGraph* process_model_;
+    const FrozenProcessGraph* frozen_model_;
 };
 
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <sqlite3.h>
 #include <optional>
 #include <functional>
+#include <string_view>
 
 namespace procmine {
 
@@ -43,7 +44,7 @@ private:
 
 class Database {
 public:
-    Database(const std::string& db_path);
+    Database(const std::string& db_path, bool read_only = false);
     ~Database();
     
     bool execute(const std::string& sql);
@@ -56,14 +57,24 @@ public:
         ~Statement();
         
         void bind(int index, int value);
+        void bind(int index, int64_t value);
         void bind(int index, double value);
         void bind(int index, const std::string& value);
         void bind(int index, std::nullptr_t);
+        void bind_static(int index, std::string_view value);
         
         bool execute();
         
         std::shared_ptr<QueryResult> query();
         
+        bool step();
+        void reset();
+        
+        bool column_is_null(int col) const;
+        int64_t column_int64(int col) const;
+        double column_double(int col) const;
+        std::string_view column_text(int col) const;
+        
     private:
         sqlite3_stmt* stmt_;
     };
@@ -78,10 +89,14 @@ public:
     
     int64_t last_insert_rowid() const;
     
+    int get_variable_limit() const;
+    
     int get_error_code() const;
     
     std::string get_error_message() const;
     
+    static std::string quote_identifier(const std::string& identifier);
+    
 private:
     sqlite3* db_;
     static int query_callback(void* data, int argc, char** argv, char** col_names);
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "procmine/algorithm.h"
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace procmine {
+
+class GraphWriter {
+public:
+    explicit GraphWriter(std::ostream& out);
+    explicit GraphWriter(int fd);
+    virtual ~GraphWriter() = default;
+
+    virtual void write(const ProcessGraph& graph) = 0;
+
+    void set_buffer_size(size_t bytes);
+
+protected:
+    void append(std::string_view data);
+    void append(char c);
+    void flush();
+
+private:
+    std::ostream* stream_;
+    int fd_;
+    size_t buffer_size_;
+    std::string buffer_;
+};
+
+class DOTGraphWriter : public GraphWriter {
+public:
+    using GraphWriter::GraphWriter;
+    void write(const ProcessGraph& graph) override;
+};
+
+class JSONGraphWriter : public GraphWriter {
+public:
+    using GraphWriter::GraphWriter;
+    void write(const ProcessGraph& graph) override;
+};
+
+class BinaryGraphWriter : public GraphWriter {
+public:
+    using GraphWriter::GraphWriter;
+    void write(const ProcessGraph& graph) override;
+
+private:
+    void append_u32(uint32_t value);
+    void append_u64(uint64_t value);
+};
+
+class BinaryGraphReader {
+public:
+    explicit BinaryGraphReader(std::istream& in);
+    explicit BinaryGraphReader(int fd);
+
+    std::shared_ptr<ProcessGraph> read();
+
+private:
+    void read_exact(char* data, size_t size);
+    void read_string(std::string& out, size_t size);
+    void release_surplus();
+    uint32_t read_u32();
+    uint64_t read_u64();
+
+    std::istream* stream_;
+    int fd_;
+    std::string buffer_;
+    size_t position_;
+};
+
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include "procmine/models.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace procmine {
+
+class Bitmap {
+public:
+    Bitmap();
+
+    static Bitmap range(uint32_t begin, uint32_t end);
+
+    void add(uint32_t value);
+    void add_range(uint32_t begin, uint32_t end);
+    bool contains(uint32_t value) const;
+
+    uint64_t cardinality() const;
+    bool empty() const;
+
+    Bitmap operator&(const Bitmap& other) const;
+    Bitmap operator|(const Bitmap& other) const;
+    Bitmap and_not(const Bitmap& other) const;
+
+    std::vector<uint32_t> to_vector() const;
+
+    template <typename Function>
+    void for_each(Function&& function) const {
+        for (const auto& container : containers_) {
+            uint32_t high = static_cast<uint32_t>(container.key) << 16;
+            if (container.words.empty()) {
+                for (uint16_t low : container.array) {
+                    function(high | low);
+                }
+                continue;
+            }
+            for (size_t w = 0; w < container.words.size(); ++w) {
+                uint64_t word = container.words[w];
+                while (word != 0) {
+                    int bit = __builtin_ctzll(word);
+                    function(high | static_cast<uint32_t>(w * 64 + bit));
+                    word &= word - 1;
+                }
+            }
+        }
+    }
+
+private:
+    struct Container {
+        uint16_t key = 0;
+        uint32_t cardinality = 0;
+        std::vector<uint16_t> array;
+        std::vector<uint64_t> words;
+
+        bool contains(uint16_t low) const;
+        void to_bitset();
+        void normalize();
+    };
+
+    static Container intersect(const Container& a, const Container& b);
+    static Container unite(const Container& a, const Container& b);
+    static Container subtract(const Container& a, const Container& b);
+
+    Container& container_for(uint16_t key);
+
+    std::vector<Container> containers_;
+};
+
+class Predicate {
+public:
+    enum class Kind {
+        Activity,
+        Resource,
+        Attribute,
+        CaseId,
+        TraceLength,
+        Variant,
+        EventuallyFollows,
+        And,
+        Or,
+        Not
+    };
+
+    static Predicate activity(const std::string& activity);
+    static Predicate resource(const std::string& resource);
+    static Predicate attribute(const std::string& name, const std::string& value);
+    static Predicate case_id(const std::string& case_id);
+    static Predicate trace_length(size_t min_length, size_t max_length);
+    static Predicate variant(const std::vector<std::string>& activities);
+    static Predicate eventually_follows(const std::string& first, const std::string& second);
+
+    Predicate operator&&(const Predicate& other) const;
+    Predicate operator||(const Predicate& other) const;
+    Predicate operator!() const;
+
+    Kind get_kind() const;
+    bool is_trace_level() const;
+
+private:
+    friend class FilterEngine;
+
+    struct Node {
+        Kind kind;
+        std::vector<std::string> values;
+        size_t min_length = 0;
+        size_t max_length = 0;
+        std::vector<std::shared_ptr<const Node>> children;
+    };
+
+    explicit Predicate(std::shared_ptr<const Node> node);
+
+    std::shared_ptr<const Node> node_;
+};
+
+class FilterEngine {
+public:
+    FilterEngine(const EventLog& log);
+
+    const EventLog& get_log() const;
+    size_t event_count() const;
+
+    const Bitmap& activity_events(const std::string& activity) const;
+    const Bitmap& resource_events(const std::string& resource) const;
+
+    Bitmap evaluate(const Predicate& predicate) const;
+    Bitmap matching_traces(const Predicate& predicate) const;
+
+    LogView select_events(const Predicate& predicate) const;
+    LogView select_traces(const Predicate& predicate) const;
+
+private:
+    Bitmap evaluate(const Predicate::Node& node) const;
+    Bitmap evaluate_traces(const Predicate::Node& node) const;
+    Bitmap traces_to_events(const Bitmap& traces) const;
+    Bitmap events_to_traces(const Bitmap& events) const;
+
+    const EventLog& log_;
+    std::vector<uint32_t> offsets_;
+    std::unordered_map<std::string, Bitmap> activities_;
+    std::unordered_map<std::string, Bitmap> resources_;
+    Bitmap empty_;
+};
+
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "procmine/algorithm.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace procmine {
+
+class LogGenerator {
+public:
+    LogGenerator(const ProcessGraph& model);
+
+    void set_start_activities(const std::vector<std::string>& activities);
+    void set_end_activities(const std::vector<std::string>& activities);
+    void set_end_probability(double probability);
+    void set_loop_probability(double probability);
+    void set_noise(double probability);
+    void set_max_trace_length(size_t length);
+
+    void set_duration(const std::string& activity, double mean_seconds, double stddev_seconds = 0.0);
+    void set_default_duration(double mean_seconds, double stddev_seconds = 0.0);
+    void set_start_time(std::chrono::system_clock::time_point start);
+    void set_case_interval(double seconds);
+    void set_resource_count(size_t resources);
+
+    void set_seed(uint64_t seed);
+    void set_parallelism(unsigned threads);
+    void set_batch_size(size_t traces);
+
+    std::shared_ptr<EventLog> generate(size_t traces, size_t first_case = 0) const;
+    void write_csv(const std::string& filepath, size_t traces, char delimiter = ',') const;
+    void write_sqlite(const std::string& db_path, const std::string& table_name, size_t traces) const;
+
+private:
+    struct Duration {
+        double mean;
+        double stddev;
+    };
+
+    struct Choice {
+        uint32_t target;
+        double weight;
+    };
+
+    uint32_t node_id(const std::string& activity) const;
+    Trace play_out(size_t case_index, std::vector<uint64_t>& visited,
+                   const Trace::allocator_type& allocator) const;
+    double sample_duration(uint32_t activity, std::mt19937_64& random) const;
+    uint32_t pick(const std::vector<Choice>& choices, double total, std::mt19937_64& random) const;
+
+    std::vector<std::string> names_;
+    std::unordered_map<std::string, uint32_t> ids_;
+    std::vector<std::vector<Choice>> choices_;
+    std::vector<uint32_t> starts_;
+    std::vector<uint8_t> is_end_;
+    std::vector<Duration> durations_;
+    double end_probability_;
+    std::optional<double> loop_probability_;
+    double noise_;
+    size_t max_trace_length_;
+    std::chrono::system_clock::time_point start_time_;
+    double case_interval_;
+    size_t resources_;
+    uint64_t seed_;
+    unsigned parallelism_;
+    size_t batch_size_;
+};
+
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory_resource>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifndef PROCMINE_INSTRUMENTATION
+#define PROCMINE_INSTRUMENTATION 0
+#endif
+
+namespace procmine {
+
+class Instrumentation {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Span {
+        std::string name;
+        uint32_t thread;
+        int64_t start_us;
+        int64_t duration_us;
+    };
+
+    static Instrumentation& instance();
+
+    void set_enabled(bool enabled);
+    bool is_enabled() const;
+
+    void add_counter(std::string_view name, int64_t value);
+    void record_span(std::string_view name, Clock::time_point start, Clock::time_point end);
+
+    std::map<std::string, int64_t> get_counters() const;
+    std::vector<Span> get_spans() const;
+
+    void write_chrome_trace(std::ostream& out) const;
+    void write_metrics(std::ostream& out) const;
+    void reset();
+
+private:
+    Instrumentation();
+
+    uint32_t thread_index();
+
+    std::atomic<bool> enabled_;
+    Clock::time_point origin_;
+    mutable std::mutex mutex_;
+    std::map<std::string, int64_t, std::less<>> counters_;
+    std::vector<Span> spans_;
+    std::unordered_map<std::thread::id, uint32_t> threads_;
+};
+
+class ScopedSpan {
+public:
+    explicit ScopedSpan(std::string_view name);
+    ~ScopedSpan();
+
+    ScopedSpan(const ScopedSpan&) = delete;
+    ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+private:
+    std::string_view name_;
+    bool active_;
+    Instrumentation::Clock::time_point start_;
+};
+
+class ScopedTimer {
+public:
+    explicit ScopedTimer(int64_t& total_ns)
+        : total_ns_(total_ns), start_(Instrumentation::Clock::now()) {}
+    ~ScopedTimer() {
+        total_ns_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Instrumentation::Clock::now() - start_).count();
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    int64_t& total_ns_;
+    Instrumentation::Clock::time_point start_;
+};
+
+std::pmr::memory_resource* arena_upstream_resource();
+
+}
+
+#define PROCMINE_CONCAT_IMPL(a, b) a##b
+#define PROCMINE_CONCAT(a, b) PROCMINE_CONCAT_IMPL(a, b)
+
+#if PROCMINE_INSTRUMENTATION
+#define PROCMINE_TRACE_SCOPE(name) ::procmine::ScopedSpan PROCMINE_CONCAT(procmine_span_, __LINE__)(name)
+#define PROCMINE_COUNTER_ADD(name, value) \
+    do { \
+        auto& procmine_instrumentation = ::procmine::Instrumentation::instance(); \
+        if (procmine_instrumentation.is_enabled()) { \
+            procmine_instrumentation.add_counter(name, static_cast<int64_t>(value)); \
+        } \
+    } while (false)
+#define PROCMINE_TIME_SCOPE(total) ::procmine::ScopedTimer PROCMINE_CONCAT(procmine_timer_, __LINE__)(total)
+#else
+#define PROCMINE_TRACE_SCOPE(name) static_cast<void>(0)
+#define PROCMINE_COUNTER_ADD(name, value) static_cast<void>(sizeof(value))
+#define PROCMINE_TIME_SCOPE(total) static_cast<void>(total)
+#endif
@@ -1,11 +1,35 @@
 #pragma once
 
 #include "procmine/models.h"
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <optional>
 #include <string>
 #include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace procmine {
 
+class Database;
+
+enum class SQLiteLayout {
+    Flat,
+    Normalized
+};
+
+struct LogFilter {
+    std::optional<std::chrono::system_clock::time_point> start;
+    std::optional<std::chrono::system_clock::time_point> end;
+    std::vector<std::string> activities;
+    std::vector<std::string> case_ids;
+    std::unordered_map<std::string, std::string> attributes;
+
+    bool empty() const;
+};
+
 class LogReader {
 public:
     virtual ~LogReader() = default;
@@ -21,10 +45,22 @@ public:
     void set_activity_column(const std::string& column_name);
     void set_timestamp_column(const std::string& column_name);
     void set_resource_column(const std::string& column_name);
+
+    void set_columnar_attributes(bool enabled);
+    void set_attribute_type(const std::string& column_name, AttributeType type);
+
+    void set_case_sampling(double fraction, uint64_t seed = 0);
+
+    size_t get_skipped_rows() const;
     
 private:
     std::string filepath_;
     char delimiter_;
+    bool columnar_attributes_;
+    double case_fraction_;
+    uint64_t case_seed_;
+    size_t skipped_rows_;
+    std::unordered_map<std::string, AttributeType> attribute_types_;
     std::string case_column_;
     std::string activity_column_;
     std::string timestamp_column_;
@@ -40,10 +76,44 @@ public:
     void set_activity_column(const std::string& column_name);
     void set_timestamp_column(const std::string& column_name);
     void set_resource_column(const std::string& column_name);
+
+    void set_table(const std::string& table_name, SQLiteLayout layout = SQLiteLayout::Flat);
+
+    void set_filter(const LogFilter& filter);
+    void create_filter_indexes();
+
+    void set_parallelism(unsigned threads);
+
+    void set_columnar_attributes(bool enabled);
+    void set_attribute_type(const std::string& column_name, AttributeType type);
+
+    void set_case_sampling(double fraction, uint64_t seed = 0);
     
 private:
+    struct NormalizedDimensions;
+
+    std::vector<Trace> read_flat(Database& db, const std::string& partition_condition,
+                                 const std::vector<int64_t>& partition_params,
+                                 const Trace::allocator_type& allocator) const;
+    std::vector<std::pair<int64_t, Trace>> read_normalized(
+        Database& db, const NormalizedDimensions& dimensions,
+        const std::string& partition_condition,
+        const std::vector<int64_t>& partition_params,
+        const Trace::allocator_type& allocator) const;
+    NormalizedDimensions load_dimensions(Database& db) const;
+    std::shared_ptr<EventLog> read_serial();
+    std::shared_ptr<EventLog> read_parallel();
+
     std::string db_path_;
     std::string query_;
+    std::string table_name_;
+    SQLiteLayout layout_;
+    LogFilter filter_;
+    unsigned parallelism_;
+    bool columnar_attributes_;
+    double case_fraction_;
+    uint64_t case_seed_;
+    std::unordered_map<std::string, AttributeType> attribute_types_;
     std::string case_column_;
     std::string activity_column_;
     std::string timestamp_column_;
@@ -60,20 +130,50 @@ class CSVLogWriter : public LogWriter {
 public:
     CSVLogWriter(const std::string& filepath, char delimiter = ',');
     void write(const EventLog& log) override;
+
+    std::future<void> write_async(std::shared_ptr<const EventLog> log, size_t queue_capacity = 4);
+
+    void set_compatibility_mode(bool enabled);
+    void set_parallelism(unsigned threads);
+    void set_append_mode(bool enabled);
     
 private:
+    void write_pipelined(const EventLog& log, size_t queue_capacity) const;
+    std::vector<std::string> attribute_columns(const EventLog& log) const;
+    std::ofstream open_output(bool& write_header) const;
+
     std::string filepath_;
     char delimiter_;
+    bool compatibility_mode_;
+    unsigned parallelism_;
+    bool append_mode_;
 };
 
 class SQLiteLogWriter : public LogWriter {
 public:
     SQLiteLogWriter(const std::string& db_path, const std::string& table_name);
     void write(const EventLog& log) override;
+
+    std::future<void> write_async(std::shared_ptr<const EventLog> log, size_t queue_capacity = 4);
+
+    void set_bulk_mode(bool enabled);
+    void set_batch_size(size_t rows);
+    void set_create_indexes(bool enabled);
+    void set_layout(SQLiteLayout layout);
     
 private:
+    void write_bulk(Database& db, const EventLog& log,
+                    const std::vector<std::string>& attribute_names);
+    void write_normalized(Database& db, const EventLog& log);
+    void write_pipelined(const EventLog& log, size_t queue_capacity);
+    void create_indexes(Database& db);
+
     std::string db_path_;
     std::string table_name_;
+    SQLiteLayout layout_;
+    bool bulk_mode_;
+    size_t batch_size_;
+    bool create_indexes_;
 };
 
 }
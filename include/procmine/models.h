@@ -1,46 +1,202 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iterator>
 #include <memory>
+#include <memory_resource>
+#include <optional>
 
 namespace procmine {
 
+enum class AttributeType {
+    String,
+    Int64,
+    Double,
+    Timestamp
+};
+
+class AttributeColumn {
+public:
+    AttributeColumn(const std::string& name, AttributeType type);
+
+    const std::string& get_name() const;
+    AttributeType get_type() const;
+    size_t size() const;
+
+    void set(size_t row, std::string_view value);
+    void set_null(size_t row);
+    bool is_null(size_t row) const;
+
+    uint32_t get_code(size_t row) const;
+    int64_t get_int64(size_t row) const;
+    double get_double(size_t row) const;
+    std::chrono::system_clock::time_point get_timestamp(size_t row) const;
+
+    const std::vector<std::string>& get_dictionary() const;
+    bool find_code(std::string_view value, uint32_t& code) const;
+
+    bool format(size_t row, std::string& out) const;
+    std::vector<uint8_t> equals(std::string_view value) const;
+    size_t memory_usage() const;
+
+private:
+    void resize(size_t rows);
+
+    std::string name_;
+    AttributeType type_;
+    size_t size_;
+    std::vector<uint64_t> valid_;
+    std::vector<uint32_t> codes_;
+    std::vector<int64_t> integers_;
+    std::vector<double> doubles_;
+    std::vector<std::string> dictionary_;
+    std::unordered_map<std::string, uint32_t> lookup_;
+};
+
+class AttributeSchema {
+public:
+    AttributeSchema();
+
+    size_t add_column(const std::string& name, AttributeType type = AttributeType::String);
+    const AttributeColumn* find_column(const std::string& name) const;
+    size_t column_index(const std::string& name) const;
+    size_t column_count() const;
+    const AttributeColumn& get_column(size_t index) const;
+
+    uint32_t add_row();
+    size_t row_count() const;
+    void set(uint32_t row, size_t column, std::string_view value);
+
+    std::unordered_map<std::string, std::string> get_attributes(uint32_t row) const;
+    size_t memory_usage() const;
+
+private:
+    std::vector<AttributeColumn> columns_;
+    std::unordered_map<std::string, size_t> index_;
+    size_t rows_;
+};
+
+// Since 0.2.0 events and traces are allocator-aware: Trace::get_events() returns
+// std::pmr::vector<Event> and Event::attributes is a std::pmr::unordered_map.
+// Code that named the old std:: container types must switch to the pmr ones or auto.
 struct Event {
+    using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+    static constexpr uint32_t no_attribute_row = UINT32_MAX;
+
+    Event() = default;
+    explicit Event(const allocator_type& allocator);
+    Event(const Event& other, const allocator_type& allocator);
+    Event(Event&& other, const allocator_type& allocator);
+    Event(const Event& other) = default;
+    Event(Event&& other) noexcept = default;
+    Event& operator=(const Event& other) = default;
+    Event& operator=(Event&& other) = default;
+
+    allocator_type get_allocator() const;
+
     std::string activity;
     std::string resource;
     std::chrono::system_clock::time_point timestamp;
-    std::unordered_map<std::string, std::string> attributes;
+    std::pmr::unordered_map<std::string, std::string> attributes;
+    uint32_t attribute_row = no_attribute_row;
 };
 
 class Trace {
 public:
+    using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
     Trace() : case_id_("") {}
     Trace(const std::string& case_id);
+    Trace(const std::string& case_id, const allocator_type& allocator);
+    Trace(const Trace& other, const allocator_type& allocator);
+    Trace(Trace&& other, const allocator_type& allocator);
+    Trace(const Trace& other) = default;
+    Trace(Trace&& other) noexcept = default;
+    Trace& operator=(const Trace& other) = default;
+    Trace& operator=(Trace&& other) = default;
+
+    allocator_type get_allocator() const;
+    void reserve(size_t events);
+
     void add_event(const Event& event);
     void add_event(Event&& event);
+    void append_events(Trace&& other);
+    void expand_attributes(const AttributeSchema& schema);
     
     const std::string& get_case_id() const;
-    const std::vector<Event>& get_events() const;
+    const std::pmr::vector<Event>& get_events() const;
     
     std::string get_attribute(const std::string& key) const;
     void set_attribute(const std::string& key, const std::string& value);
+    const std::unordered_map<std::string, std::string>& get_attributes() const;
     
 private:
+    friend class EventLog;
+
     std::string case_id_;
-    std::vector<Event> events_;
+    std::pmr::vector<Event> events_;
     std::unordered_map<std::string, std::string> attributes_;
 };
 
+class TimeIndex {
+public:
+    struct Entry {
+        std::chrono::system_clock::time_point timestamp;
+        uint32_t trace;
+        uint32_t event;
+    };
+
+    struct Bounds {
+        std::chrono::system_clock::time_point first;
+        std::chrono::system_clock::time_point last;
+    };
+
+    TimeIndex();
+
+    void add_trace(const Trace& trace, size_t trace_index);
+
+    size_t size() const;
+    const std::vector<Bounds>& get_bounds() const;
+    bool overlaps(size_t trace_index,
+                  const std::chrono::system_clock::time_point& start,
+                  const std::chrono::system_clock::time_point& end) const;
+
+    std::vector<Entry> range(const std::chrono::system_clock::time_point& start,
+                             const std::chrono::system_clock::time_point& end) const;
+
+private:
+    void merge_tail();
+
+    std::vector<Entry> entries_;
+    std::vector<Entry> tail_;
+    std::vector<Bounds> bounds_;
+};
+
 class EventLog {
 public:
     EventLog();
+    EventLog(const EventLog& other);
+    EventLog(EventLog&& other) noexcept;
+    EventLog& operator=(const EventLog& other);
+    EventLog& operator=(EventLog&& other);
+
+    void use_arena(size_t initial_size = 1 << 20);
+    std::pmr::memory_resource* create_arena(size_t initial_size = 1 << 20);
+    Trace::allocator_type get_allocator() const;
+
     void add_trace(const Trace& trace);
     void add_trace(Trace&& trace);
+    void add_trace(const Trace& trace, const AttributeSchema* schema);
     
     const std::vector<Trace>& get_traces() const;
+    size_t event_count() const;
     
     std::vector<std::string> get_activities() const;
     
@@ -48,9 +204,147 @@ public:
     std::shared_ptr<EventLog> filter_by_timeframe(
         const std::chrono::system_clock::time_point& start,
         const std::chrono::system_clock::time_point& end) const;
+
+    void build_time_index();
+    void drop_time_index();
+    const TimeIndex* get_time_index() const;
+
+    void set_attribute_schema(std::shared_ptr<AttributeSchema> schema);
+    const std::shared_ptr<AttributeSchema>& get_attribute_schema() const;
+    void columnarize_attributes(const std::unordered_map<std::string, AttributeType>& types = {});
+
+    bool get_event_attribute(const Event& event, const std::string& name, std::string& value) const;
+    std::unordered_map<std::string, std::string> get_event_attributes(const Event& event) const;
     
 private:
+    bool owns_resource(const std::pmr::memory_resource* resource) const;
+    void check_attribute_rows(const Trace& trace) const;
+
+    std::vector<std::unique_ptr<std::pmr::memory_resource>> arenas_;
+    std::pmr::memory_resource* resource_;
     std::vector<Trace> traces_;
+    std::optional<TimeIndex> time_index_;
+    std::shared_ptr<AttributeSchema> attribute_schema_;
+};
+
+class TraceView {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = Event;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Event*;
+        using reference = const Event&;
+
+        iterator() : view_(nullptr), index_(0) {}
+        iterator(const TraceView* view, size_t index) : view_(view), index_(index) {}
+
+        reference operator*() const { return (*view_)[index_]; }
+        pointer operator->() const { return &(*view_)[index_]; }
+        reference operator[](difference_type n) const { return (*view_)[index_ + n]; }
+
+        iterator& operator++() { ++index_; return *this; }
+        iterator operator++(int) { iterator copy = *this; ++index_; return copy; }
+        iterator& operator--() { --index_; return *this; }
+        iterator operator--(int) { iterator copy = *this; --index_; return copy; }
+        iterator& operator+=(difference_type n) { index_ += n; return *this; }
+        iterator& operator-=(difference_type n) { index_ -= n; return *this; }
+        iterator operator+(difference_type n) const { return iterator(view_, index_ + n); }
+        iterator operator-(difference_type n) const { return iterator(view_, index_ - n); }
+        friend iterator operator+(difference_type n, const iterator& it) { return it + n; }
+        difference_type operator-(const iterator& other) const {
+            return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+        }
+
+        bool operator==(const iterator& other) const { return index_ == other.index_; }
+        bool operator!=(const iterator& other) const { return index_ != other.index_; }
+        bool operator<(const iterator& other) const { return index_ < other.index_; }
+        bool operator>(const iterator& other) const { return index_ > other.index_; }
+        bool operator<=(const iterator& other) const { return index_ <= other.index_; }
+        bool operator>=(const iterator& other) const { return index_ >= other.index_; }
+
+    private:
+        const TraceView* view_;
+        size_t index_;
+    };
+
+    TraceView(const Trace& trace, const std::vector<uint32_t>* selection = nullptr);
+
+    const std::string& get_case_id() const;
+    const Trace& get_trace() const;
+
+    size_t size() const;
+    bool empty() const;
+    const Event& operator[](size_t index) const;
+    size_t event_index(size_t index) const;
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, size()); }
+    
+private:
+    const Trace* trace_;
+    const std::vector<uint32_t>* selection_;
+};
+
+class LogView {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = TraceView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = TraceView;
+
+        iterator(const LogView* view, size_t index) : view_(view), index_(index) {}
+
+        TraceView operator*() const { return view_->get_trace(index_); }
+        iterator& operator++() { ++index_; return *this; }
+        iterator operator++(int) { iterator copy = *this; ++index_; return copy; }
+        bool operator==(const iterator& other) const { return index_ == other.index_; }
+        bool operator!=(const iterator& other) const { return index_ != other.index_; }
+
+    private:
+        const LogView* view_;
+        size_t index_;
+    };
+
+    LogView(const EventLog& log);
+
+    const EventLog& get_log() const;
+
+    size_t size() const;
+    bool empty() const;
+    size_t event_count() const;
+    TraceView get_trace(size_t index) const;
+    size_t trace_index(size_t index) const;
+    const std::shared_ptr<const std::vector<uint32_t>>& get_selection(size_t index) const;
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, size()); }
+
+    std::vector<std::string> get_activities() const;
+
+    LogView filter_traces(const std::function<bool(const TraceView&)>& predicate) const;
+    LogView filter_events(const std::function<bool(const Event&)>& predicate) const;
+    LogView filter_by_activity(const std::string& activity) const;
+    LogView filter_by_timeframe(
+        const std::chrono::system_clock::time_point& start,
+        const std::chrono::system_clock::time_point& end) const;
+
+    std::shared_ptr<EventLog> materialize() const;
+
+    static LogView from_selection(const EventLog& log, std::vector<size_t> trace_indexes,
+                                  std::vector<std::shared_ptr<const std::vector<uint32_t>>> selections);
+    
+private:
+    LogView(const EventLog* log);
+
+    const EventLog* log_;
+    bool full_;
+    std::vector<size_t> trace_indexes_;
+    std::vector<std::shared_ptr<const std::vector<uint32_t>>> selections_;
 };
 
-}
\ No newline at end of file
+}
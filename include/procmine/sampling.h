@@ -0,0 +1,55 @@
+#pragma once
+
+#include "procmine/models.h"
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace procmine {
+
+bool sample_case(const std::string& case_id, double fraction, uint64_t seed = 0);
+
+struct EdgeFrequencyEstimate {
+    std::string from;
+    std::string to;
+    uint64_t sample_count;
+    double estimated_count;
+    double standard_error;
+};
+
+class TraceSampler {
+public:
+    TraceSampler(uint64_t seed = 0);
+
+    LogView reservoir(const LogView& view, size_t sample_size) const;
+    LogView stratified(const LogView& view, double fraction) const;
+    LogView hash_by_case(const LogView& view, double fraction) const;
+
+    std::vector<EdgeFrequencyEstimate> estimate_edge_frequencies(const LogView& sample,
+                                                                 size_t population_traces) const;
+
+    void set_seed(uint64_t seed);
+
+private:
+    uint64_t seed_;
+};
+
+class TraceReservoir {
+public:
+    TraceReservoir(size_t capacity, uint64_t seed = 0);
+
+    void add(const Trace& trace, const AttributeSchema* schema = nullptr);
+
+    uint64_t seen() const;
+    std::shared_ptr<EventLog> to_log() const;
+
+private:
+    size_t capacity_;
+    uint64_t seen_;
+    std::mt19937_64 random_;
+    std::vector<Trace> traces_;
+};
+
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace procmine {
+
+uint64_t sketch_hash(std::string_view data, uint64_t seed = 0);
+
+class TDigest {
+public:
+    explicit TDigest(double compression = 100.0);
+
+    void add(double value, double weight = 1.0);
+    void merge(const TDigest& other);
+
+    double quantile(double q) const;
+    double count() const;
+    double min() const;
+    double max() const;
+    double mean() const;
+    bool empty() const;
+
+    double get_compression() const;
+    size_t centroid_count() const;
+    size_t memory_usage() const;
+
+private:
+    struct Centroid {
+        double mean;
+        double weight;
+    };
+
+    void compress() const;
+    void flush_buffer() const;
+
+    double compression_;
+    // quantile() folds the buffer into the centroids in place, so concurrent
+    // readers of one digest still need external synchronization.
+    mutable std::vector<Centroid> centroids_;
+    mutable std::vector<Centroid> buffer_;
+    double total_weight_;
+    double sum_;
+    double min_;
+    double max_;
+};
+
+class CountMinSketch {
+public:
+    CountMinSketch(size_t width, size_t depth, uint64_t seed = 0);
+
+    static CountMinSketch with_error(double epsilon, double delta, uint64_t seed = 0);
+
+    void set_conservative_update(bool enabled);
+
+    uint64_t add(uint64_t key, uint64_t count = 1);
+    uint64_t estimate(uint64_t key) const;
+    void merge(const CountMinSketch& other);
+
+    uint64_t total() const;
+    size_t width() const;
+    size_t depth() const;
+    double error_bound() const;
+    size_t memory_usage() const;
+
+private:
+    size_t column(uint64_t key, size_t row) const;
+
+    size_t width_;
+    size_t depth_;
+    uint64_t seed_;
+    bool conservative_;
+    uint64_t total_;
+    std::vector<uint64_t> counters_;
+};
+
+class HyperLogLog {
+public:
+    explicit HyperLogLog(unsigned precision = 12);
+
+    void add(std::string_view value);
+    void add_hash(uint64_t hash);
+    void merge(const HyperLogLog& other);
+
+    double estimate() const;
+    unsigned get_precision() const;
+    size_t memory_usage() const;
+
+private:
+    unsigned precision_;
+    std::vector<uint8_t> registers_;
+};
+
+class SpaceSaving {
+public:
+    struct Counter {
+        uint64_t key;
+        uint64_t count;
+        uint64_t error;
+    };
+
+    explicit SpaceSaving(size_t capacity);
+
+    std::optional<uint64_t> add(uint64_t key, uint64_t count = 1);
+    void merge(const SpaceSaving& other);
+
+    bool contains(uint64_t key) const;
+    uint64_t estimate(uint64_t key) const;
+    std::vector<Counter> top(size_t k) const;
+
+    uint64_t total() const;
+    uint64_t min_count() const;
+    size_t size() const;
+    size_t get_capacity() const;
+    size_t memory_usage() const;
+
+private:
+    void sift_down(size_t index);
+    void swap_entries(size_t a, size_t b);
+
+    size_t capacity_;
+    uint64_t total_;
+    std::vector<Counter> heap_;
+    std::unordered_map<uint64_t, size_t> positions_;
+};
+
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "procmine/models.h"
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace procmine {
+
+class MiningSummary {
+public:
+    MiningSummary();
+    MiningSummary(const LogView& view);
+
+    void add_trace(const Trace& trace);
+    void add_trace(const TraceView& trace);
+    void merge(const MiningSummary& other);
+
+    uint64_t trace_count() const;
+    const std::map<std::string, uint64_t>& get_activity_counts() const;
+    const std::map<std::string, uint64_t>& get_start_counts() const;
+    const std::map<std::string, uint64_t>& get_end_counts() const;
+    const std::map<std::pair<std::string, std::string>, uint64_t>& get_transition_counts() const;
+    const std::map<std::vector<std::string>, uint64_t>& get_variant_counts() const;
+
+    std::string serialize() const;
+    static MiningSummary deserialize(std::string_view data);
+
+    void write(std::ostream& out) const;
+    static MiningSummary read(std::istream& in);
+
+    bool operator==(const MiningSummary& other) const;
+
+private:
+    template <typename Events>
+    void add_events(const Events& events);
+
+    uint64_t traces_;
+    std::map<std::string, uint64_t> activities_;
+    std::map<std::string, uint64_t> starts_;
+    std::map<std::string, uint64_t> ends_;
+    std::map<std::pair<std::string, std::string>, uint64_t> transitions_;
+    std::map<std::vector<std::string>, uint64_t> variants_;
+};
+
+}
@@ -1,11 +1,50 @@
 #include "procmine/algorithm.h"
+#include "procmine/concurrency.h"
+#include "procmine/export.h"
+#include "procmine/instrumentation.h"
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <queue>
 #include <sstream>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
 #include <iostream>
 #include <boost/graph/breadth_first_search.hpp>
 
 namespace procmine {
 
+namespace {
+
+int frequency_count(uint64_t count) {
+    if (count > static_cast<uint64_t>(std::numeric_limits<int>::max())) {
+        throw std::runtime_error("Summary count " + std::to_string(count) + " exceeds the frequency metric range");
+    }
+    return static_cast<int>(count);
+}
+
+uint64_t hash_name(std::string_view name) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (unsigned char c : name) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+uint64_t mix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+}
+
 ProcessGraph::ProcessGraph() {}
 
 Vertex ProcessGraph::add_node(const std::string& activity) {
@@ -17,7 +56,6 @@ Vertex ProcessGraph::add_node(const std::string& activity) {
     Vertex v = boost::add_vertex(graph_);
     graph_[v].activity = activity;
     activity_to_vertex_[activity] = v;
-    vertex_to_activity_[v] = activity;
     return v;
 }
 
@@ -26,6 +64,7 @@ Edge ProcessGraph::add_edge(const Vertex& from, const Vertex& to, double weight)
     Edge e;
     tie(e, exists) = boost::add_edge(from, to, graph_);
     graph_[e].weight = weight;
+    edge_weights_[edge_key(from, to)] = weight;
     return e;
 }
 
@@ -35,11 +74,52 @@ Edge ProcessGraph::add_edge(const std::string& from, const std::string& to, doub
     return add_edge(v_from, v_to, weight);
 }
 
+uint64_t ProcessGraph::edge_key(Vertex from, Vertex to) {
+    return (static_cast<uint64_t>(from) << 32) ^ static_cast<uint64_t>(to);
+}
+
+size_t ProcessGraph::node_count() const {
+    return boost::num_vertices(graph_);
+}
+
+Vertex ProcessGraph::find_node(std::string_view activity) const {
+    auto it = activity_to_vertex_.find(activity);
+    return it == activity_to_vertex_.end() ? npos : it->second;
+}
+
+std::string_view ProcessGraph::get_name(Vertex node) const {
+    return graph_[node].activity;
+}
+
+ProcessGraph::OutEdgeRange ProcessGraph::out_edges(Vertex node) const {
+    auto range = boost::out_edges(node, graph_);
+    return OutEdgeRange(&graph_, range.first, range.second);
+}
+
+bool ProcessGraph::has_edge(Vertex from, Vertex to) const {
+    return edge_weights_.count(edge_key(from, to)) > 0;
+}
+
+bool ProcessGraph::has_edge(std::string_view from, std::string_view to) const {
+    Vertex source = find_node(from);
+    Vertex target = find_node(to);
+    return source != npos && target != npos && has_edge(source, target);
+}
+
+bool ProcessGraph::find_edge(Vertex from, Vertex to, double& weight) const {
+    auto it = edge_weights_.find(edge_key(from, to));
+    if (it == edge_weights_.end()) {
+        return false;
+    }
+    weight = it->second;
+    return true;
+}
+
 std::vector<std::string> ProcessGraph::get_nodes() const {
     std::vector<std::string> result;
-    auto vertices = boost::vertices(graph_);
-    for (auto vit = vertices.first; vit != vertices.second; ++vit) {
-        result.push_back(graph_[*vit].activity);
+    result.reserve(node_count());
+    for (Vertex v = 0; v < node_count(); ++v) {
+        result.emplace_back(get_name(v));
     }
     return result;
 }
@@ -47,59 +127,236 @@ std::vector<std::string> ProcessGraph::get_nodes() const {
 std::vector<ProcessGraph::EdgeInfo> ProcessGraph::get_outgoing_edges(const std::string& node) const {
     std::vector<EdgeInfo> result;
     
-    auto it = activity_to_vertex_.find(node);
-    if (it == activity_to_vertex_.end()) {
+    Vertex v = find_node(node);
+    if (v == npos) {
         return result;
     }
     
-    Vertex v = it->second;
-    auto out_edges = boost::out_edges(v, graph_);
-    
-    for (auto eit = out_edges.first; eit != out_edges.second; ++eit) {
-        Vertex target = boost::target(*eit, graph_);
-        
-        EdgeInfo info;
-        info.from = node;
-        info.to = vertex_to_activity_.at(target);
-        info.weight = graph_[*eit].weight;
-        
-        result.push_back(info);
+    for (const EdgeRef& edge : out_edges(v)) {
+        result.push_back({node, std::string(get_name(edge.to)), edge.weight});
     }
     
     return result;
 }
 
 std::string ProcessGraph::to_dot() const {
-    std::stringstream ss;
+    std::ostringstream ss;
+    DOTGraphWriter(ss).write(*this);
+    return ss.str();
+}
 
-    boost::write_graphviz(
-        ss, graph_,
-        [this](std::ostream& out, const Vertex& v) {
-            out << "[label=\"" << graph_[v].activity << "\", shape=box]";
-        },
-        [this](std::ostream& out, const Edge& e) {
-            out << "[label=\"" << graph_[e].weight << "\"]";
+std::shared_ptr<const FrozenProcessGraph> ProcessGraph::freeze() const {
+    return std::make_shared<const FrozenProcessGraph>(*this);
+}
+
+FrozenProcessGraph::FrozenProcessGraph(const ProcessGraph& graph) : seed_(0) {
+    const ProcessModelGraph& g = graph.get_graph();
+    const size_t nodes = boost::num_vertices(g);
+    const size_t edges = boost::num_edges(g);
+    if (nodes >= npos || edges >= UINT32_MAX) {
+        throw std::runtime_error("Process graph too large to freeze");
+    }
+
+    name_offsets_.reserve(nodes + 1);
+    name_offsets_.push_back(0);
+    for (size_t v = 0; v < nodes; ++v) {
+        names_ += g[v].activity;
+        name_offsets_.push_back(static_cast<uint32_t>(names_.size()));
+    }
+
+    offsets_.reserve(nodes + 1);
+    offsets_.push_back(0);
+    targets_.reserve(edges);
+    weights_.reserve(edges);
+
+    std::vector<std::pair<uint32_t, double>> out;
+    for (size_t v = 0; v < nodes; ++v) {
+        out.clear();
+        auto range = boost::out_edges(v, g);
+        for (auto eit = range.first; eit != range.second; ++eit) {
+            out.emplace_back(static_cast<uint32_t>(boost::target(*eit, g)), g[*eit].weight);
         }
-    );
-    
-    return ss.str();
+        std::stable_sort(out.begin(), out.end(), [](const auto& a, const auto& b) {
+            return a.first < b.first;
+        });
+        for (const auto& edge : out) {
+            targets_.push_back(edge.first);
+            weights_.push_back(edge.second);
+        }
+        offsets_.push_back(static_cast<uint32_t>(targets_.size()));
+    }
+
+    if (nodes == 0) {
+        return;
+    }
+
+    const size_t buckets = (nodes + 3) / 4;
+    const size_t table = nodes + nodes / 4 + 1;
+    std::vector<uint64_t> hashes(nodes);
+    std::vector<std::vector<uint32_t>> members(buckets);
+    std::vector<size_t> order(buckets);
+    std::vector<uint32_t> candidate;
+
+    for (uint64_t attempt = 0;; ++attempt) {
+        seed_ = mix(attempt);
+        for (auto& bucket : members) {
+            bucket.clear();
+        }
+        for (uint32_t node = 0; node < nodes; ++node) {
+            hashes[node] = hash_name(get_name(node)) ^ seed_;
+            members[mix(hashes[node]) % buckets].push_back(node);
+        }
+
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return members[a].size() > members[b].size();
+        });
+
+        displacements_.assign(buckets, 0);
+        slots_.assign(table, npos);
+        bool placed_all = true;
+
+        for (size_t bucket : order) {
+            const auto& keys = members[bucket];
+            if (keys.empty()) {
+                break;
+            }
+
+            bool placed = false;
+            for (uint32_t d = 0; d < (1u << 16) && !placed; ++d) {
+                candidate.clear();
+                placed = true;
+                for (uint32_t node : keys) {
+                    uint32_t slot = static_cast<uint32_t>(mix(hashes[node] ^ mix(d + 1)) % table);
+                    if (slots_[slot] != npos ||
+                        std::find(candidate.begin(), candidate.end(), slot) != candidate.end()) {
+                        placed = false;
+                        break;
+                    }
+                    candidate.push_back(slot);
+                }
+                if (placed) {
+                    displacements_[bucket] = d;
+                    for (size_t i = 0; i < keys.size(); ++i) {
+                        slots_[candidate[i]] = keys[i];
+                    }
+                }
+            }
+
+            if (!placed) {
+                placed_all = false;
+                break;
+            }
+        }
+
+        if (placed_all) {
+            return;
+        }
+    }
+}
+
+size_t FrozenProcessGraph::node_count() const {
+    return offsets_.size() - 1;
+}
+
+size_t FrozenProcessGraph::edge_count() const {
+    return targets_.size();
+}
+
+uint32_t FrozenProcessGraph::slot_for(std::string_view activity) const {
+    uint64_t hash = hash_name(activity) ^ seed_;
+    uint32_t d = displacements_[mix(hash) % displacements_.size()];
+    return static_cast<uint32_t>(mix(hash ^ mix(d + 1)) % slots_.size());
+}
+
+uint32_t FrozenProcessGraph::find_node(std::string_view activity) const {
+    if (slots_.empty()) {
+        return npos;
+    }
+    uint32_t node = slots_[slot_for(activity)];
+    return node != npos && get_name(node) == activity ? node : npos;
+}
+
+std::string_view FrozenProcessGraph::get_name(uint32_t node) const {
+    return std::string_view(names_).substr(name_offsets_[node], name_offsets_[node + 1] - name_offsets_[node]);
+}
+
+std::span<const uint32_t> FrozenProcessGraph::out_targets(uint32_t node) const {
+    return std::span<const uint32_t>(targets_.data() + offsets_[node], offsets_[node + 1] - offsets_[node]);
+}
+
+std::span<const double> FrozenProcessGraph::out_weights(uint32_t node) const {
+    return std::span<const double>(weights_.data() + offsets_[node], offsets_[node + 1] - offsets_[node]);
+}
+
+bool FrozenProcessGraph::has_edge(uint32_t from, uint32_t to) const {
+    auto targets = out_targets(from);
+    return std::binary_search(targets.begin(), targets.end(), to);
+}
+
+bool FrozenProcessGraph::find_edge(uint32_t from, uint32_t to, double& weight) const {
+    auto targets = out_targets(from);
+    auto it = std::lower_bound(targets.begin(), targets.end(), to);
+    if (it == targets.end() || *it != to) {
+        return false;
+    }
+    weight = weights_[offsets_[from] + (it - targets.begin())];
+    return true;
+}
+
+std::vector<std::string> FrozenProcessGraph::get_nodes() const {
+    std::vector<std::string> result;
+    result.reserve(node_count());
+    for (uint32_t node = 0; node < node_count(); ++node) {
+        result.emplace_back(get_name(node));
+    }
+    return result;
+}
+
+std::vector<ProcessGraph::EdgeInfo> FrozenProcessGraph::get_outgoing_edges(const std::string& node) const {
+    std::vector<ProcessGraph::EdgeInfo> result;
+
+    uint32_t from = find_node(node);
+    if (from == npos) {
+        return result;
+    }
+
+    auto targets = out_targets(from);
+    auto weights = out_weights(from);
+    for (size_t i = 0; i < targets.size(); ++i) {
+        result.push_back({node, std::string(get_name(targets[i])), weights[i]});
+    }
+    return result;
+}
+
+std::shared_ptr<ProcessGraph> MiningAlgorithm::mine(const LogView& view) {
+    std::shared_ptr<EventLog> log;
+    {
+        PROCMINE_TRACE_SCOPE("view.materialize");
+        log = view.materialize();
+    }
+    return mine(*log);
 }
 
 AlphaAlgorithm::AlphaAlgorithm() {}
 
 std::shared_ptr<ProcessGraph> AlphaAlgorithm::mine(const EventLog& log) {
+    return mine(LogView(log));
+}
+
+std::shared_ptr<ProcessGraph> AlphaAlgorithm::mine(const LogView& view) {
+    PROCMINE_TRACE_SCOPE("mine.alpha");
     auto result = std::make_shared<ProcessGraph>();
 
-    auto activities = log.get_activities();
+    auto activities = view.get_activities();
 
     for (const auto& activity : activities) {
         result->add_node(activity);
     }
 
-    for (const auto& trace : log.get_traces()) {
-        const auto& events = trace.get_events();
-        for (size_t i = 0; i < events.size() - 1; ++i) {
-            result->add_edge(events[i].activity, events[i + 1].activity);
+    for (const auto& trace : view) {
+        for (size_t i = 0; i + 1 < trace.size(); ++i) {
+            result->add_edge(trace[i].activity, trace[i + 1].activity);
         }
     }
     
@@ -112,33 +369,67 @@ HeuristicMiner::HeuristicMiner(double dependency_threshold,
       positive_observations_threshold_(positive_observations_threshold) {}
 
 std::shared_ptr<ProcessGraph> HeuristicMiner::mine(const EventLog& log) {
-    auto result = std::make_shared<ProcessGraph>();
+    return mine(LogView(log));
+}
+
+std::shared_ptr<ProcessGraph> HeuristicMiner::mine(const LogView& view) {
+    PROCMINE_TRACE_SCOPE("mine.heuristic");
+    std::unordered_map<std::string, std::unordered_map<std::string, uint64_t>> transitions;
+    
+    for (const auto& trace : view) {
+        for (size_t i = 0; i + 1 < trace.size(); ++i) {
+            transitions[trace[i].activity][trace[i + 1].activity]++;
+        }
+    }
+
+    return build_graph(view.get_activities(), transitions);
+}
+
+std::shared_ptr<ProcessGraph> HeuristicMiner::mine(const MiningSummary& summary) {
+    PROCMINE_TRACE_SCOPE("mine.heuristic_summary");
+    std::vector<std::string> activities;
+    for (const auto& entry : summary.get_activity_counts()) {
+        activities.push_back(entry.first);
+    }
+
+    std::unordered_map<std::string, std::unordered_map<std::string, uint64_t>> transitions;
+    for (const auto& [edge, count] : summary.get_transition_counts()) {
+        transitions[edge.first][edge.second] = count;
+    }
+
+    return build_graph(std::move(activities), transitions);
+}
+
+std::shared_ptr<ProcessGraph> HeuristicMiner::build_graph(
+    std::vector<std::string> activities,
+    const std::unordered_map<std::string, std::unordered_map<std::string, uint64_t>>& transitions) const {
 
-    auto activities = log.get_activities();
+    auto result = std::make_shared<ProcessGraph>();
 
+    std::sort(activities.begin(), activities.end());
     for (const auto& activity : activities) {
         result->add_node(activity);
     }
 
-    std::unordered_map<std::string, std::unordered_map<std::string, int>> transitions;
-    
-    for (const auto& trace : log.get_traces()) {
-        const auto& events = trace.get_events();
-        for (size_t i = 0; i < events.size() - 1; ++i) {
-            transitions[events[i].activity][events[i + 1].activity]++;
+    auto count = [&transitions](const std::string& from, const std::string& to) {
+        auto outgoing = transitions.find(from);
+        if (outgoing == transitions.end()) {
+            return 0.0;
         }
-    }
+        auto it = outgoing->second.find(to);
+        return it == outgoing->second.end() ? 0.0 : static_cast<double>(it->second);
+    };
 
     for (const auto& from_activity : activities) {
         for (const auto& to_activity : activities) {
             if (from_activity == to_activity) continue;
             
-            int a_to_b = transitions[from_activity][to_activity];
-            int b_to_a = transitions[to_activity][from_activity];
+            double a_to_b = count(from_activity, to_activity);
+            double b_to_a = count(to_activity, from_activity);
 
             double dependency = 0.0;
             if (a_to_b + b_to_a > 0) {
-                dependency = ((double)(a_to_b - b_to_a)) / ((double)(a_to_b + b_to_a + 1));
+                dependency = (a_to_b - b_to_a) / (a_to_b + b_to_a + 1);
             }
 
             if (dependency > dependency_threshold_ && a_to_b > positive_observations_threshold_) {
@@ -150,119 +441,1659 @@ std::shared_ptr<ProcessGraph> HeuristicMiner::mine(const EventLog& log) {
     return result;
 }
 
-FrequencyAnalyzer::FrequencyAnalyzer() {}
+ProcessTree::ProcessTree(Operator op, const std::string& label) : operator_(op), label_(label) {}
 
-FrequencyAnalyzer::FrequencyMetrics FrequencyAnalyzer::analyze(const EventLog& log) {
-    FrequencyMetrics metrics;
+std::shared_ptr<ProcessTree> ProcessTree::activity(const std::string& label) {
+    return std::make_shared<ProcessTree>(Operator::Activity, label);
+}
 
-    for (const auto& trace : log.get_traces()) {
-        const auto& events = trace.get_events();
+std::shared_ptr<ProcessTree> ProcessTree::tau() {
+    return std::make_shared<ProcessTree>(Operator::Tau);
+}
 
-        std::vector<std::string> variant;
-        for (const auto& event : events) {
-            variant.push_back(event.activity);
-            metrics.activity_frequency[event.activity]++;
+void ProcessTree::add_child(std::shared_ptr<ProcessTree> child) {
+    children_.push_back(std::move(child));
+}
+
+ProcessTree::Operator ProcessTree::get_operator() const {
+    return operator_;
+}
+
+const std::string& ProcessTree::get_label() const {
+    return label_;
+}
+
+const std::vector<std::shared_ptr<ProcessTree>>& ProcessTree::get_children() const {
+    return children_;
+}
+
+std::string ProcessTree::to_string() const {
+    switch (operator_) {
+        case Operator::Activity:
+            return label_;
+        case Operator::Tau:
+            return "tau";
+        default:
+            break;
+    }
+
+    std::string result;
+    switch (operator_) {
+        case Operator::Sequence: result = "->("; break;
+        case Operator::Exclusive: result = "X("; break;
+        case Operator::Parallel: result = "+("; break;
+        default: result = "*("; break;
+    }
+    for (size_t i = 0; i < children_.size(); ++i) {
+        if (i > 0) {
+            result += ", ";
         }
+        result += children_[i]->to_string();
+    }
+    return result + ")";
+}
 
-        std::string variant_str;
-        for (const auto& activity : variant) {
-            if (!variant_str.empty()) variant_str += "->";
-            variant_str += activity;
+namespace {
+
+class ActivitySet {
+public:
+    explicit ActivitySet(size_t size = 0) : words_((size + 63) / 64, 0) {}
+
+    void set(size_t index) { words_[index >> 6] |= uint64_t(1) << (index & 63); }
+    bool test(size_t index) const { return (words_[index >> 6] >> (index & 63)) & 1; }
+
+    ActivitySet& operator|=(const ActivitySet& other) {
+        for (size_t i = 0; i < words_.size(); ++i) {
+            words_[i] |= other.words_[i];
         }
+        return *this;
+    }
 
-        metrics.variant_frequency[variant_str]++;
+    bool intersects(const ActivitySet& other) const {
+        for (size_t i = 0; i < words_.size(); ++i) {
+            if (words_[i] & other.words_[i]) {
+                return true;
+            }
+        }
+        return false;
+    }
 
-        metrics.variant_traces[variant_str] = variant;
+    bool any() const {
+        return std::any_of(words_.begin(), words_.end(), [](uint64_t word) { return word != 0; });
+    }
 
-        for (size_t i = 0; i < events.size() - 1; ++i) {
-            metrics.transition_frequency[events[i].activity][events[i + 1].activity]++;
+    template <typename Function>
+    void for_each(Function&& function) const {
+        for (size_t w = 0; w < words_.size(); ++w) {
+            uint64_t word = words_[w];
+            while (word != 0) {
+                function(w * 64 + __builtin_ctzll(word));
+                word &= word - 1;
+            }
+        }
+    }
+
+    std::vector<uint64_t>& words() { return words_; }
+    const std::vector<uint64_t>& words() const { return words_; }
+
+private:
+    std::vector<uint64_t> words_;
+};
+
+struct TreeLanguage {
+    std::unordered_set<std::string> starts;
+    std::unordered_set<std::string> ends;
+    std::unordered_set<std::string> activities;
+    bool nullable = false;
+};
+
+void connect_sets(ProcessGraph& graph, const std::unordered_set<std::string>& from,
+                  const std::unordered_set<std::string>& to) {
+    for (const auto& source : from) {
+        for (const auto& target : to) {
+            if (!graph.has_edge(std::string_view(source), std::string_view(target))) {
+                graph.add_edge(source, target, 1.0);
+            }
         }
     }
-    
-    return metrics;
 }
 
-std::shared_ptr<ProcessGraph> FrequencyAnalyzer::build_process_graph(
-    const FrequencyMetrics& metrics, double threshold) {
-    
-    auto graph = std::make_shared<ProcessGraph>();
+TreeLanguage add_tree_edges(const ProcessTree& tree, ProcessGraph& graph) {
+    TreeLanguage language;
+    const auto& children = tree.get_children();
 
-    for (const auto& activity_pair : metrics.activity_frequency) {
-        graph->add_node(activity_pair.first);
+    switch (tree.get_operator()) {
+        case ProcessTree::Operator::Activity:
+            graph.add_node(tree.get_label());
+            language.starts = language.ends = language.activities = {tree.get_label()};
+            return language;
+        case ProcessTree::Operator::Tau:
+            language.nullable = true;
+            return language;
+        default:
+            break;
     }
 
-    for (const auto& from_pair : metrics.transition_frequency) {
-        for (const auto& to_pair : from_pair.second) {
-            double frequency = static_cast<double>(to_pair.second);
-            
-            if (frequency > threshold) {
-                graph->add_edge(from_pair.first, to_pair.first, frequency);
+    std::vector<TreeLanguage> parts;
+    for (const auto& child : children) {
+        parts.push_back(add_tree_edges(*child, graph));
+        language.activities.insert(parts.back().activities.begin(), parts.back().activities.end());
+    }
+
+    auto merge = [](std::unordered_set<std::string>& into, const std::unordered_set<std::string>& from) {
+        into.insert(from.begin(), from.end());
+    };
+
+    switch (tree.get_operator()) {
+        case ProcessTree::Operator::Sequence: {
+            language.nullable = true;
+            for (size_t i = 0; i < parts.size(); ++i) {
+                if (language.nullable) {
+                    merge(language.starts, parts[i].starts);
+                }
+                language.nullable = language.nullable && parts[i].nullable;
+                for (size_t j = i + 1; j < parts.size(); ++j) {
+                    connect_sets(graph, parts[i].ends, parts[j].starts);
+                    if (!parts[j].nullable) {
+                        break;
+                    }
+                }
+            }
+            for (size_t i = parts.size(); i-- > 0;) {
+                merge(language.ends, parts[i].ends);
+                if (!parts[i].nullable) {
+                    break;
+                }
+            }
+            break;
+        }
+        case ProcessTree::Operator::Exclusive:
+            for (const auto& part : parts) {
+                merge(language.starts, part.starts);
+                merge(language.ends, part.ends);
+                language.nullable = language.nullable || part.nullable;
             }
+            break;
+        case ProcessTree::Operator::Parallel:
+            language.nullable = true;
+            for (size_t i = 0; i < parts.size(); ++i) {
+                merge(language.starts, parts[i].starts);
+                merge(language.ends, parts[i].ends);
+                language.nullable = language.nullable && parts[i].nullable;
+                for (size_t j = 0; j < parts.size(); ++j) {
+                    if (i != j) {
+                        connect_sets(graph, parts[i].activities, parts[j].activities);
+                    }
+                }
+            }
+            break;
+        default: {
+            const TreeLanguage& body = parts[0];
+            language = body;
+            language.activities.clear();
+            for (const auto& part : parts) {
+                merge(language.activities, part.activities);
+            }
+            for (size_t i = 1; i < parts.size(); ++i) {
+                connect_sets(graph, body.ends, parts[i].starts);
+                connect_sets(graph, parts[i].ends, body.starts);
+                if (body.nullable) {
+                    merge(language.starts, parts[i].starts);
+                    merge(language.ends, parts[i].ends);
+                    connect_sets(graph, parts[i].ends, parts[i].starts);
+                }
+            }
+            break;
         }
     }
-    
-    return graph;
+
+    return language;
 }
 
-ConformanceChecker::ConformanceChecker(const ProcessGraph& process_model)
-    : process_model_(process_model) {}
+class InductiveContext {
+public:
+    InductiveContext(const LogView& view, TaskPool* pool) : pool_(pool) {
+        std::unordered_map<std::string, uint32_t> lookup;
+        ids_.resize(view.get_log().get_traces().size());
+        for (size_t i = 0; i < view.size(); ++i) {
+            const Trace& trace = view.get_trace(i).get_trace();
+            auto& ids = ids_[view.trace_index(i)];
+            if (!ids.empty() || trace.get_events().empty()) {
+                continue;
+            }
+            ids.reserve(trace.get_events().size());
+            for (const auto& event : trace.get_events()) {
+                auto slot = lookup.try_emplace(event.activity, static_cast<uint32_t>(names_.size()));
+                if (slot.second) {
+                    names_.push_back(event.activity);
+                }
+                ids.push_back(slot.first->second);
+            }
+        }
+    }
 
-ConformanceChecker::ConformanceResult ConformanceChecker::check_trace(const Trace& trace) {
-    ConformanceResult result;
-    result.total_activities = trace.get_events().size();
-    result.matched_activities = 0;
-    
-    const auto& events = trace.get_events();
+    std::shared_ptr<ProcessTree> mine(const LogView& view) const {
+        if (view.empty()) {
+            return ProcessTree::tau();
+        }
 
-    for (size_t i = 0; i < events.size() - 1; ++i) {
-        const std::string& from = events[i].activity;
-        const std::string& to = events[i + 1].activity;
+        DFG dfg = build_dfg(view);
+        const size_t k = dfg.activities.size();
 
-        auto edges = process_model_.get_outgoing_edges(from);
+        if (k == 0) {
+            return ProcessTree::tau();
+        }
 
-        bool found = false;
-        for (const auto& edge : edges) {
-            if (edge.to == to) {
-                found = true;
-                result.matched_activities++;
-                break;
+        if (dfg.empty_traces > 0) {
+            auto tree = std::make_shared<ProcessTree>(ProcessTree::Operator::Exclusive);
+            tree->add_child(ProcessTree::tau());
+            tree->add_child(mine(view.filter_traces([](const TraceView& trace) { return !trace.empty(); })));
+            return tree;
+        }
+
+        if (k == 1) {
+            auto leaf = ProcessTree::activity(names_[dfg.activities[0]]);
+            if (dfg.events == view.size()) {
+                return leaf;
             }
+            auto loop = std::make_shared<ProcessTree>(ProcessTree::Operator::Loop);
+            loop->add_child(leaf);
+            loop->add_child(ProcessTree::tau());
+            return loop;
         }
-        
-        if (!found) {
-            std::string violation = "Transition from '" + from + "' to '" + to + "' not found in model";
-            result.violations.push_back(violation);
+
+        auto groups = exclusive_cut(dfg);
+        if (groups.size() > 1) {
+            return recurse(ProcessTree::Operator::Exclusive, split_exclusive(view, dfg, groups));
+        }
+
+        groups = sequence_cut(dfg);
+        if (groups.size() > 1) {
+            return recurse(ProcessTree::Operator::Sequence, split_projection(view, dfg, groups));
+        }
+
+        groups = parallel_cut(dfg);
+        if (groups.size() > 1) {
+            return recurse(ProcessTree::Operator::Parallel, split_projection(view, dfg, groups));
+        }
+
+        groups = loop_cut(dfg);
+        if (groups.size() > 1) {
+            return recurse(ProcessTree::Operator::Loop, split_loop(view, dfg, groups));
+        }
+
+        auto choice = std::make_shared<ProcessTree>(ProcessTree::Operator::Exclusive);
+        for (uint32_t activity : dfg.activities) {
+            choice->add_child(ProcessTree::activity(names_[activity]));
         }
+        auto flower = std::make_shared<ProcessTree>(ProcessTree::Operator::Loop);
+        flower->add_child(choice);
+        flower->add_child(ProcessTree::tau());
+        return flower;
     }
 
-    if (!events.empty()) {
-        auto nodes = process_model_.get_nodes();
-        if (std::find(nodes.begin(), nodes.end(), events.back().activity) != nodes.end()) {
-            result.matched_activities++;
+private:
+    struct DFG {
+        std::vector<uint32_t> activities;
+        std::unordered_map<uint32_t, uint32_t> local;
+        std::vector<ActivitySet> successors;
+        std::vector<ActivitySet> predecessors;
+        ActivitySet starts;
+        ActivitySet ends;
+        size_t empty_traces = 0;
+        size_t events = 0;
+    };
+
+    uint32_t activity_of(const LogView& view, size_t trace, const TraceView& events, size_t event) const {
+        return ids_[view.trace_index(trace)][events.event_index(event)];
+    }
+
+    DFG build_dfg(const LogView& view) const {
+        DFG dfg;
+        for (size_t t = 0; t < view.size(); ++t) {
+            TraceView trace = view.get_trace(t);
+            if (trace.empty()) {
+                dfg.empty_traces++;
+            }
+            for (size_t e = 0; e < trace.size(); ++e) {
+                uint32_t activity = activity_of(view, t, trace, e);
+                if (dfg.local.try_emplace(activity, static_cast<uint32_t>(dfg.activities.size())).second) {
+                    dfg.activities.push_back(activity);
+                }
+            }
+        }
+
+        const size_t k = dfg.activities.size();
+        dfg.successors.assign(k, ActivitySet(k));
+        dfg.predecessors.assign(k, ActivitySet(k));
+        dfg.starts = ActivitySet(k);
+        dfg.ends = ActivitySet(k);
+
+        for (size_t t = 0; t < view.size(); ++t) {
+            TraceView trace = view.get_trace(t);
+            if (trace.empty()) {
+                continue;
+            }
+            dfg.events += trace.size();
+            uint32_t previous = dfg.local[activity_of(view, t, trace, 0)];
+            dfg.starts.set(previous);
+            for (size_t e = 1; e < trace.size(); ++e) {
+                uint32_t current = dfg.local[activity_of(view, t, trace, e)];
+                dfg.successors[previous].set(current);
+                dfg.predecessors[current].set(previous);
+                previous = current;
+            }
+            dfg.ends.set(previous);
         }
+        return dfg;
     }
 
-    if (result.total_activities > 0) {
-        result.fitness = static_cast<double>(result.matched_activities) / result.total_activities;
-    } else {
-        result.fitness = 1.0;
+    static ActivitySet full_set(size_t k) {
+        ActivitySet set(k);
+        for (size_t i = 0; i < k; ++i) {
+            set.set(i);
+        }
+        return set;
     }
-    
-    return result;
-}
 
-std::vector<ConformanceChecker::ConformanceResult> ConformanceChecker::check_log(const EventLog& log) {
-    std::vector<ConformanceResult> results;
-    
-    for (const auto& trace : log.get_traces()) {
-        results.push_back(check_trace(trace));
+    template <typename Neighbors>
+    static std::vector<ActivitySet> components(size_t k, const ActivitySet& members, Neighbors&& neighbors) {
+        std::vector<ActivitySet> result;
+        ActivitySet visited(k);
+        std::vector<size_t> stack;
+
+        members.for_each([&](size_t root) {
+            if (visited.test(root)) {
+                return;
+            }
+            ActivitySet component(k);
+            visited.set(root);
+            stack.push_back(root);
+            while (!stack.empty()) {
+                size_t current = stack.back();
+                stack.pop_back();
+                component.set(current);
+                ActivitySet next = neighbors(current);
+                auto& words = next.words();
+                for (size_t w = 0; w < words.size(); ++w) {
+                    words[w] &= members.words()[w] & ~visited.words()[w];
+                }
+                next.for_each([&](size_t activity) {
+                    visited.set(activity);
+                    stack.push_back(activity);
+                });
+            }
+            result.push_back(std::move(component));
+        });
+        return result;
     }
-    
-    return results;
-}
 
-double ConformanceChecker::calculate_overall_conformance(const EventLog& log) {
-    auto results = check_log(log);
+    static std::vector<ActivitySet> exclusive_cut(const DFG& dfg) {
+        const size_t k = dfg.activities.size();
+        return components(k, full_set(k), [&](size_t a) {
+            ActivitySet next = dfg.successors[a];
+            next |= dfg.predecessors[a];
+            return next;
+        });
+    }
+
+    static std::vector<ActivitySet> sequence_cut(const DFG& dfg) {
+        const size_t k = dfg.activities.size();
+
+        std::vector<std::vector<uint32_t>> adjacency(k);
+        for (size_t a = 0; a < k; ++a) {
+            dfg.successors[a].for_each([&](size_t b) { adjacency[a].push_back(static_cast<uint32_t>(b)); });
+        }
+
+        std::vector<int> index(k, -1), lowlink(k, 0), component_of(k, -1);
+        std::vector<uint8_t> on_stack(k, 0);
+        std::vector<uint32_t> stack;
+        std::vector<std::pair<uint32_t, size_t>> work;
+        int counter = 0;
+        int components = 0;
+
+        for (uint32_t root = 0; root < k; ++root) {
+            if (index[root] != -1) {
+                continue;
+            }
+            work.emplace_back(root, 0);
+            while (!work.empty()) {
+                auto& [v, next] = work.back();
+                if (next == 0 && index[v] == -1) {
+                    index[v] = lowlink[v] = counter++;
+                    stack.push_back(v);
+                    on_stack[v] = 1;
+                }
+                if (next < adjacency[v].size()) {
+                    uint32_t w = adjacency[v][next++];
+                    if (index[w] == -1) {
+                        work.emplace_back(w, 0);
+                    } else if (on_stack[w]) {
+                        lowlink[v] = std::min(lowlink[v], index[w]);
+                    }
+                    continue;
+                }
+                if (lowlink[v] == index[v]) {
+                    uint32_t w;
+                    do {
+                        w = stack.back();
+                        stack.pop_back();
+                        on_stack[w] = 0;
+                        component_of[w] = components;
+                    } while (w != v);
+                    components++;
+                }
+                uint32_t finished = v;
+                work.pop_back();
+                if (!work.empty()) {
+                    uint32_t parent = work.back().first;
+                    lowlink[parent] = std::min(lowlink[parent], lowlink[finished]);
+                }
+            }
+        }
+
+        const size_t c = static_cast<size_t>(components);
+        std::vector<ActivitySet> reach(c, ActivitySet(c));
+        std::vector<ActivitySet> direct(c, ActivitySet(c));
+        for (size_t a = 0; a < k; ++a) {
+            for (uint32_t b : adjacency[a]) {
+                if (component_of[a] != component_of[b]) {
+                    direct[component_of[a]].set(component_of[b]);
+                }
+            }
+        }
+        for (size_t i = 0; i < c; ++i) {
+            direct[i].for_each([&](size_t j) {
+                reach[i].set(j);
+                reach[i] |= reach[j];
+            });
+        }
+
+        std::vector<size_t> group(c);
+        std::iota(group.begin(), group.end(), 0);
+        std::function<size_t(size_t)> find = [&](size_t x) {
+            return group[x] == x ? x : group[x] = find(group[x]);
+        };
+        for (size_t i = 0; i < c; ++i) {
+            for (size_t j = i + 1; j < c; ++j) {
+                if (!reach[i].test(j) && !reach[j].test(i)) {
+                    group[find(i)] = find(j);
+                }
+            }
+        }
+
+        std::vector<size_t> order;
+        std::vector<int> position(c, -1);
+        for (size_t i = c; i-- > 0;) {
+            size_t root = find(i);
+            if (position[root] == -1) {
+                position[root] = static_cast<int>(order.size());
+                order.push_back(root);
+            }
+        }
+        if (order.size() < 2) {
+            return {};
+        }
+
+        for (size_t i = 0; i < c; ++i) {
+            for (size_t j = 0; j < c; ++j) {
+                int pi = position[find(i)];
+                int pj = position[find(j)];
+                if (pi < pj && (!reach[i].test(j) || reach[j].test(i))) {
+                    return {};
+                }
+            }
+        }
+
+        std::vector<ActivitySet> groups(order.size(), ActivitySet(k));
+        for (size_t a = 0; a < k; ++a) {
+            groups[position[find(component_of[a])]].set(a);
+        }
+        return groups;
+    }
+
+    static std::vector<ActivitySet> parallel_cut(const DFG& dfg) {
+        const size_t k = dfg.activities.size();
+        const ActivitySet all = full_set(k);
+        auto groups = components(k, all, [&](size_t a) {
+            ActivitySet next(k);
+            auto& words = next.words();
+            for (size_t w = 0; w < words.size(); ++w) {
+                words[w] = ~(dfg.successors[a].words()[w] & dfg.predecessors[a].words()[w]) & all.words()[w];
+            }
+            return next;
+        });
+
+        std::vector<ActivitySet> valid;
+        std::vector<ActivitySet> invalid;
+        for (auto& group : groups) {
+            if (group.intersects(dfg.starts) && group.intersects(dfg.ends)) {
+                valid.push_back(std::move(group));
+            } else {
+                invalid.push_back(std::move(group));
+            }
+        }
+        if (valid.empty()) {
+            return {};
+        }
+        for (const auto& group : invalid) {
+            valid[0] |= group;
+        }
+        return valid.size() > 1 ? valid : std::vector<ActivitySet>{};
+    }
+
+    static std::vector<ActivitySet> loop_cut(const DFG& dfg) {
+        const size_t k = dfg.activities.size();
+        ActivitySet body = dfg.starts;
+        body |= dfg.ends;
+
+        ActivitySet rest(k);
+        for (size_t a = 0; a < k; ++a) {
+            if (!body.test(a)) {
+                rest.set(a);
+            }
+        }
+
+        auto candidates = components(k, rest, [&](size_t a) {
+            ActivitySet next = dfg.successors[a];
+            next |= dfg.predecessors[a];
+            return next;
+        });
+
+        std::vector<uint8_t> merged(candidates.size(), 0);
+        for (bool changed = true; changed;) {
+            changed = false;
+            for (size_t i = 0; i < candidates.size(); ++i) {
+                if (merged[i]) {
+                    continue;
+                }
+                bool into_body = false;
+                candidates[i].for_each([&](size_t a) {
+                    for (size_t w = 0; w < body.words().size() && !into_body; ++w) {
+                        uint64_t non_end_body = body.words()[w] & ~dfg.ends.words()[w];
+                        uint64_t non_start_body = body.words()[w] & ~dfg.starts.words()[w];
+                        into_body = (dfg.predecessors[a].words()[w] & non_end_body) ||
+                                    (dfg.successors[a].words()[w] & non_start_body);
+                    }
+                });
+                if (into_body) {
+                    body |= candidates[i];
+                    merged[i] = 1;
+                    changed = true;
+                }
+            }
+        }
+
+        std::vector<ActivitySet> groups{body};
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            if (!merged[i]) {
+                groups.push_back(candidates[i]);
+            }
+        }
+        return groups.size() > 1 ? groups : std::vector<ActivitySet>{};
+    }
+
+    static std::vector<int> group_lookup(const DFG& dfg, const std::vector<ActivitySet>& groups) {
+        std::vector<int> group_of(dfg.activities.size(), -1);
+        for (size_t g = 0; g < groups.size(); ++g) {
+            groups[g].for_each([&](size_t a) { group_of[a] = static_cast<int>(g); });
+        }
+        return group_of;
+    }
+
+    struct SubLog {
+        std::vector<size_t> traces;
+        std::vector<std::shared_ptr<const std::vector<uint32_t>>> selections;
+    };
+
+    std::vector<LogView> finish(const LogView& view, std::vector<SubLog>& sublogs) const {
+        std::vector<LogView> views;
+        for (auto& sublog : sublogs) {
+            views.push_back(LogView::from_selection(view.get_log(), std::move(sublog.traces),
+                                                    std::move(sublog.selections)));
+        }
+        return views;
+    }
+
+    std::vector<LogView> split_exclusive(const LogView& view, const DFG& dfg,
+                                         const std::vector<ActivitySet>& groups) const {
+        auto group_of = group_lookup(dfg, groups);
+        std::vector<SubLog> sublogs(groups.size());
+        for (size_t t = 0; t < view.size(); ++t) {
+            TraceView trace = view.get_trace(t);
+            int g = group_of[dfg.local.at(activity_of(view, t, trace, 0))];
+            sublogs[g].traces.push_back(view.trace_index(t));
+            sublogs[g].selections.push_back(view.get_selection(t));
+        }
+        return finish(view, sublogs);
+    }
+
+    std::vector<LogView> split_projection(const LogView& view, const DFG& dfg,
+                                          const std::vector<ActivitySet>& groups) const {
+        auto group_of = group_lookup(dfg, groups);
+        std::vector<SubLog> sublogs(groups.size());
+        std::vector<std::vector<uint32_t>> selections(groups.size());
+
+        for (size_t t = 0; t < view.size(); ++t) {
+            TraceView trace = view.get_trace(t);
+            for (auto& selection : selections) {
+                selection.clear();
+            }
+            for (size_t e = 0; e < trace.size(); ++e) {
+                int g = group_of[dfg.local.at(activity_of(view, t, trace, e))];
+                selections[g].push_back(static_cast<uint32_t>(trace.event_index(e)));
+            }
+            for (size_t g = 0; g < groups.size(); ++g) {
+                sublogs[g].traces.push_back(view.trace_index(t));
+                sublogs[g].selections.push_back(std::make_shared<const std::vector<uint32_t>>(selections[g]));
+            }
+        }
+        return finish(view, sublogs);
+    }
+
+    std::vector<LogView> split_loop(const LogView& view, const DFG& dfg,
+                                    const std::vector<ActivitySet>& groups) const {
+        auto group_of = group_lookup(dfg, groups);
+        std::vector<SubLog> sublogs(groups.size());
+        auto empty = std::make_shared<const std::vector<uint32_t>>();
+
+        for (size_t t = 0; t < view.size(); ++t) {
+            TraceView trace = view.get_trace(t);
+            const size_t trace_index = view.trace_index(t);
+            bool expect_body = true;
+            std::vector<uint32_t> segment;
+            int current = -1;
+
+            auto emit = [&] {
+                if (current == 0) {
+                    expect_body = false;
+                } else {
+                    if (expect_body) {
+                        sublogs[0].traces.push_back(trace_index);
+                        sublogs[0].selections.push_back(empty);
+                    }
+                    expect_body = true;
+                }
+                sublogs[current].traces.push_back(trace_index);
+                sublogs[current].selections.push_back(std::make_shared<const std::vector<uint32_t>>(segment));
+                segment.clear();
+            };
+
+            for (size_t e = 0; e < trace.size(); ++e) {
+                int g = group_of[dfg.local.at(activity_of(view, t, trace, e))];
+                if (g != current && current != -1) {
+                    emit();
+                }
+                current = g;
+                segment.push_back(static_cast<uint32_t>(trace.event_index(e)));
+            }
+            if (current != -1) {
+                emit();
+            }
+            if (expect_body) {
+                sublogs[0].traces.push_back(trace_index);
+                sublogs[0].selections.push_back(empty);
+            }
+        }
+        return finish(view, sublogs);
+    }
+
+    std::shared_ptr<ProcessTree> recurse(ProcessTree::Operator op, const std::vector<LogView>& views) const {
+        auto tree = std::make_shared<ProcessTree>(op);
+        std::vector<std::shared_ptr<ProcessTree>> children(views.size());
+
+        if (pool_ == nullptr) {
+            for (size_t i = 0; i < views.size(); ++i) {
+                children[i] = mine(views[i]);
+            }
+        } else {
+            std::vector<std::future<std::shared_ptr<ProcessTree>>> pending;
+            struct SettleGuard {
+                TaskPool* pool;
+                std::vector<std::future<std::shared_ptr<ProcessTree>>>& pending;
+                ~SettleGuard() {
+                    for (auto& future : pending) {
+                        if (future.valid()) {
+                            pool->settle(future);
+                        }
+                    }
+                }
+            } guard{pool_, pending};
+            for (size_t i = 1; i < views.size(); ++i) {
+                pending.push_back(pool_->submit([this, &views, i] { return mine(views[i]); }));
+            }
+            children[0] = mine(views[0]);
+            for (size_t i = 1; i < views.size(); ++i) {
+                children[i] = pool_->wait(pending[i - 1]);
+            }
+        }
+
+        for (auto& child : children) {
+            tree->add_child(std::move(child));
+        }
+        return tree;
+    }
+
+    std::vector<std::vector<uint32_t>> ids_;
+    std::vector<std::string> names_;
+    TaskPool* pool_;
+};
+
+}
+
+std::shared_ptr<ProcessGraph> ProcessTree::to_process_graph() const {
+    auto graph = std::make_shared<ProcessGraph>();
+    add_tree_edges(*this, *graph);
+    return graph;
+}
+
+InductiveMiner::InductiveMiner() : parallelism_(1) {}
+
+std::shared_ptr<ProcessGraph> InductiveMiner::mine(const EventLog& log) {
+    return mine(LogView(log));
+}
+
+std::shared_ptr<ProcessGraph> InductiveMiner::mine(const LogView& view) {
+    return mine_tree(view)->to_process_graph();
+}
+
+std::shared_ptr<ProcessTree> InductiveMiner::mine_tree(const EventLog& log) {
+    return mine_tree(LogView(log));
+}
+
+std::shared_ptr<ProcessTree> InductiveMiner::mine_tree(const LogView& view) {
+    PROCMINE_TRACE_SCOPE("mine.inductive");
+    const unsigned threads = resolve_thread_count(parallelism_);
+    if (threads <= 1) {
+        return InductiveContext(view, nullptr).mine(view);
+    }
+    TaskPool pool(threads - 1);
+    return InductiveContext(view, &pool).mine(view);
+}
+
+void InductiveMiner::set_parallelism(unsigned threads) {
+    parallelism_ = threads;
+}
+
+TransitionSketch::TransitionSketch(double epsilon, double delta, size_t heavy_hitters)
+    : counts_(CountMinSketch::with_error(epsilon, delta)), capacity_(heavy_hitters), minimum_(UINT64_MAX) {
+    heavy_hitters_.reserve(capacity_ + 1);
+}
+
+uint64_t TransitionSketch::pair_key(const std::string& from, const std::string& to) {
+    return sketch_hash(to, sketch_hash(from));
+}
+
+void TransitionSketch::add(const std::string& from, const std::string& to, uint64_t count) {
+    uint64_t key = pair_key(from, to);
+    offer(key, from, to, counts_.add(key, count));
+}
+
+uint64_t TransitionSketch::estimate(const std::string& from, const std::string& to) const {
+    return counts_.estimate(pair_key(from, to));
+}
+
+void TransitionSketch::offer(uint64_t key, const std::string& from, const std::string& to, uint64_t count) {
+    if (capacity_ == 0) {
+        return;
+    }
+
+    auto it = heavy_hitters_.find(key);
+    if (it != heavy_hitters_.end()) {
+        it->second.count = count;
+        return;
+    }
+
+    if (heavy_hitters_.size() < capacity_) {
+        heavy_hitters_.emplace(key, HeavyHitter{from, to, count});
+        minimum_ = std::min(minimum_, count);
+        return;
+    }
+
+    if (count <= minimum_) {
+        return;
+    }
+
+    auto smallest = std::min_element(heavy_hitters_.begin(), heavy_hitters_.end(),
+        [](const auto& a, const auto& b) { return a.second.count < b.second.count; });
+    if (count <= smallest->second.count) {
+        minimum_ = smallest->second.count;
+        return;
+    }
+
+    heavy_hitters_.erase(smallest);
+    heavy_hitters_.emplace(key, HeavyHitter{from, to, count});
+    minimum_ = std::min_element(heavy_hitters_.begin(), heavy_hitters_.end(),
+        [](const auto& a, const auto& b) { return a.second.count < b.second.count; })->second.count;
+}
+
+void TransitionSketch::merge(const TransitionSketch& other) {
+    counts_.merge(other.counts_);
+
+    std::unordered_map<uint64_t, HeavyHitter> candidates = std::move(heavy_hitters_);
+    candidates.insert(other.heavy_hitters_.begin(), other.heavy_hitters_.end());
+
+    std::vector<std::pair<uint64_t, HeavyHitter>> ranked;
+    ranked.reserve(candidates.size());
+    for (auto& [key, candidate] : candidates) {
+        candidate.count = counts_.estimate(key);
+        ranked.emplace_back(key, std::move(candidate));
+    }
+    std::sort(ranked.begin(), ranked.end(), [](const auto& a, const auto& b) {
+        if (a.second.count != b.second.count) {
+            return a.second.count > b.second.count;
+        }
+        return a.first < b.first;
+    });
+    if (ranked.size() > capacity_) {
+        ranked.resize(capacity_);
+    }
+
+    heavy_hitters_.clear();
+    minimum_ = UINT64_MAX;
+    for (auto& [key, candidate] : ranked) {
+        minimum_ = std::min(minimum_, candidate.count);
+        heavy_hitters_.emplace(key, std::move(candidate));
+    }
+}
+
+std::vector<ProcessGraph::EdgeInfo> TransitionSketch::top_transitions() const {
+    std::vector<ProcessGraph::EdgeInfo> result;
+    result.reserve(heavy_hitters_.size());
+    for (const auto& entry : heavy_hitters_) {
+        const HeavyHitter& hitter = entry.second;
+        result.push_back({hitter.from, hitter.to, static_cast<double>(hitter.count)});
+    }
+    std::sort(result.begin(), result.end(), [](const auto& a, const auto& b) {
+        if (a.weight != b.weight) {
+            return a.weight > b.weight;
+        }
+        return a.from != b.from ? a.from < b.from : a.to < b.to;
+    });
+    return result;
+}
+
+uint64_t TransitionSketch::total() const {
+    return counts_.total();
+}
+
+double TransitionSketch::error_bound() const {
+    return counts_.error_bound();
+}
+
+size_t TransitionSketch::memory_usage() const {
+    size_t bytes = sizeof(*this) + counts_.memory_usage() - sizeof(counts_);
+    for (const auto& entry : heavy_hitters_) {
+        bytes += sizeof(entry) + entry.second.from.capacity() + entry.second.to.capacity();
+    }
+    return bytes;
+}
+
+VariantTracker::VariantTracker(size_t capacity) : counters_(capacity) {
+    sequences_.reserve(capacity);
+}
+
+template <typename Sequence>
+void VariantTracker::add_sequence(const Sequence& events, uint64_t count) {
+    auto activity_of = [](const auto& item) -> const std::string& {
+        if constexpr (std::is_same_v<std::decay_t<decltype(item)>, std::string>) {
+            return item;
+        } else {
+            return item.activity;
+        }
+    };
+
+    uint64_t hash = sketch_hash("");
+    for (const auto& item : events) {
+        hash = sketch_hash(activity_of(item), hash);
+    }
+
+    auto evicted = counters_.add(hash, count);
+    if (evicted) {
+        sequences_.erase(*evicted);
+    }
+    if (sequences_.find(hash) == sequences_.end()) {
+        std::vector<std::string> activities;
+        activities.reserve(events.size());
+        for (const auto& item : events) {
+            activities.push_back(activity_of(item));
+        }
+        sequences_.emplace(hash, std::move(activities));
+    }
+}
+
+void VariantTracker::add(const Trace& trace) {
+    add_sequence(trace.get_events(), 1);
+}
+
+void VariantTracker::add(const TraceView& trace) {
+    add_sequence(trace, 1);
+}
+
+void VariantTracker::add(const std::vector<std::string>& activities, uint64_t count) {
+    add_sequence(activities, count);
+}
+
+void VariantTracker::merge(const VariantTracker& other) {
+    counters_.merge(other.counters_);
+
+    for (const auto& entry : other.sequences_) {
+        if (counters_.contains(entry.first)) {
+            sequences_.insert(entry);
+        }
+    }
+    for (auto it = sequences_.begin(); it != sequences_.end();) {
+        it = counters_.contains(it->first) ? std::next(it) : sequences_.erase(it);
+    }
+}
+
+std::vector<VariantTracker::VariantEstimate> VariantTracker::top(size_t k) const {
+    std::vector<VariantEstimate> result;
+    for (const auto& counter : counters_.top(k)) {
+        result.push_back({sequences_.at(counter.key), counter.count, counter.error});
+    }
+    return result;
+}
+
+uint64_t VariantTracker::total() const {
+    return counters_.total();
+}
+
+uint64_t VariantTracker::error_bound() const {
+    return counters_.total() / counters_.get_capacity();
+}
+
+size_t VariantTracker::memory_usage() const {
+    size_t bytes = sizeof(*this) + counters_.memory_usage() - sizeof(counters_);
+    for (const auto& entry : sequences_) {
+        bytes += sizeof(entry) + entry.second.capacity() * sizeof(std::string);
+        for (const auto& activity : entry.second) {
+            bytes += activity.capacity();
+        }
+    }
+    return bytes;
+}
+
+FrequencyAnalyzer::FrequencyAnalyzer() {}
+
+FrequencyAnalyzer::FrequencyMetrics FrequencyAnalyzer::analyze(const EventLog& log) {
+    return analyze(LogView(log));
+}
+
+FrequencyAnalyzer::FrequencyMetrics FrequencyAnalyzer::analyze(const LogView& view) {
+    PROCMINE_TRACE_SCOPE("analyze.frequency");
+    FrequencyMetrics metrics;
+
+    for (const auto& trace : view) {
+        std::vector<std::string> variant;
+        for (const auto& event : trace) {
+            variant.push_back(event.activity);
+            metrics.activity_frequency[event.activity]++;
+        }
+
+        std::string variant_str;
+        for (const auto& activity : variant) {
+            if (!variant_str.empty()) variant_str += "->";
+            variant_str += activity;
+        }
+
+        metrics.variant_frequency[variant_str]++;
+
+        metrics.variant_traces[variant_str] = variant;
+
+        for (size_t i = 0; i + 1 < trace.size(); ++i) {
+            metrics.transition_frequency[trace[i].activity][trace[i + 1].activity]++;
+        }
+    }
+    
+    return metrics;
+}
+FrequencyAnalyzer::FrequencyMetrics FrequencyAnalyzer::analyze(const MiningSummary& summary) {
+    PROCMINE_TRACE_SCOPE("analyze.frequency_summary");
+    FrequencyMetrics metrics;
+
+    for (const auto& [activity, count] : summary.get_activity_counts()) {
+        metrics.activity_frequency[activity] = frequency_count(count);
+    }
+
+    for (const auto& [edge, count] : summary.get_transition_counts()) {
+        metrics.transition_frequency[edge.first][edge.second] = frequency_count(count);
+    }
+
+    for (const auto& [variant, count] : summary.get_variant_counts()) {
+        std::string variant_str;
+        for (const auto& activity : variant) {
+            if (!variant_str.empty()) variant_str += "->";
+            variant_str += activity;
+        }
+        int& frequency = metrics.variant_frequency[variant_str];
+        frequency = frequency_count(static_cast<uint64_t>(frequency) + count);
+        metrics.variant_traces[variant_str] = variant;
+    }
+
+    return metrics;
+}
+
+std::shared_ptr<ProcessGraph> FrequencyAnalyzer::build_process_graph(
+    const FrequencyMetrics& metrics, double threshold) {
+    
+    auto graph = std::make_shared<ProcessGraph>();
+
+    std::vector<std::string> activities;
+    activities.reserve(metrics.activity_frequency.size());
+    for (const auto& activity_pair : metrics.activity_frequency) {
+        activities.push_back(activity_pair.first);
+    }
+    std::sort(activities.begin(), activities.end());
+    for (const auto& activity : activities) {
+        graph->add_node(activity);
+    }
+
+    std::vector<std::tuple<std::string, std::string, double>> edges;
+    for (const auto& from_pair : metrics.transition_frequency) {
+        for (const auto& to_pair : from_pair.second) {
+            double frequency = static_cast<double>(to_pair.second);
+            
+            if (frequency > threshold) {
+                edges.emplace_back(from_pair.first, to_pair.first, frequency);
+            }
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    for (const auto& [from, to, frequency] : edges) {
+        graph->add_edge(from, to, frequency);
+    }
+    
+    return graph;
+}
+
+TransitionSketch FrequencyAnalyzer::sketch_transitions(const EventLog& log, double epsilon,
+                                                       double delta, size_t heavy_hitters) {
+    return sketch_transitions(LogView(log), epsilon, delta, heavy_hitters);
+}
+
+TransitionSketch FrequencyAnalyzer::sketch_transitions(const LogView& view, double epsilon,
+                                                       double delta, size_t heavy_hitters) {
+    PROCMINE_TRACE_SCOPE("analyze.sketch_transitions");
+    TransitionSketch sketch(epsilon, delta, heavy_hitters);
+
+    for (const auto& trace : view) {
+        for (size_t i = 0; i + 1 < trace.size(); ++i) {
+            sketch.add(trace[i].activity, trace[i + 1].activity);
+        }
+    }
+
+    return sketch;
+}
+
+std::shared_ptr<ProcessGraph> FrequencyAnalyzer::build_process_graph(
+    const TransitionSketch& sketch, double threshold) {
+
+    auto graph = std::make_shared<ProcessGraph>();
+
+    for (const auto& edge : sketch.top_transitions()) {
+        if (edge.weight > threshold) {
+            graph->add_edge(edge.from, edge.to, edge.weight);
+        }
+    }
+
+    return graph;
+}
+
+VariantTracker FrequencyAnalyzer::track_variants(const EventLog& log, size_t capacity) {
+    return track_variants(LogView(log), capacity);
+}
+
+VariantTracker FrequencyAnalyzer::track_variants(const LogView& view, size_t capacity) {
+    PROCMINE_TRACE_SCOPE("analyze.track_variants");
+    VariantTracker tracker(capacity);
+
+    for (const auto& trace : view) {
+        tracker.add(trace);
+    }
+
+    return tracker;
+}
+
+PerformanceAnalyzer::PerformanceAnalyzer(double compression)
+    : compression_(compression), parallelism_(1) {}
+
+PerformanceAnalyzer::PerformanceMetrics PerformanceAnalyzer::analyze(const EventLog& log) {
+    return analyze(LogView(log));
+}
+
+PerformanceAnalyzer::PerformanceMetrics PerformanceAnalyzer::analyze(const LogView& view) {
+    PROCMINE_TRACE_SCOPE("analyze.performance");
+    const size_t traces = view.size();
+    const unsigned workers = static_cast<unsigned>(
+        std::max<size_t>(1, std::min<size_t>(resolve_thread_count(parallelism_), traces)));
+    std::vector<PerformanceMetrics> partials(workers);
+
+    auto digest_for = [this](std::unordered_map<std::string, TDigest>& digests,
+                             const std::string& activity) -> TDigest& {
+        auto it = digests.find(activity);
+        if (it == digests.end()) {
+            it = digests.emplace(activity, TDigest(compression_)).first;
+        }
+        return it->second;
+    };
+
+    auto process = [&](unsigned worker) {
+        PerformanceMetrics& local = partials[worker];
+        const size_t begin = traces * worker / workers;
+        const size_t end = traces * (worker + 1) / workers;
+
+        for (size_t t = begin; t < end; ++t) {
+            TraceView trace = view.get_trace(t);
+            for (size_t i = 1; i < trace.size(); ++i) {
+                const Event& from = trace[i - 1];
+                const Event& to = trace[i];
+                double duration = std::chrono::duration<double>(to.timestamp - from.timestamp).count();
+                digest_for(local.sojourn_time, to.activity).add(duration);
+                digest_for(local.transition_time[from.activity], to.activity).add(duration);
+            }
+        }
+    };
+
+    if (workers == 1) {
+        process(0);
+    } else {
+        run_workers(workers, process);
+    }
+
+    PerformanceMetrics metrics = std::move(partials[0]);
+    for (unsigned worker = 1; worker < workers; ++worker) {
+        for (const auto& [activity, digest] : partials[worker].sojourn_time) {
+            digest_for(metrics.sojourn_time, activity).merge(digest);
+        }
+        for (const auto& [from, targets] : partials[worker].transition_time) {
+            auto& merged = metrics.transition_time[from];
+            for (const auto& [to, digest] : targets) {
+                digest_for(merged, to).merge(digest);
+            }
+        }
+    }
+
+    return metrics;
+}
+
+PerformanceAnalyzer::LatencyStatistics PerformanceAnalyzer::summarize(const TDigest& digest) {
+    LatencyStatistics statistics;
+    statistics.count = static_cast<uint64_t>(std::llround(digest.count()));
+    statistics.mean = digest.mean();
+    statistics.min = digest.min();
+    statistics.max = digest.max();
+    statistics.p50 = digest.quantile(0.5);
+    statistics.p95 = digest.quantile(0.95);
+    statistics.p99 = digest.quantile(0.99);
+    return statistics;
+}
+
+std::shared_ptr<ProcessGraph> PerformanceAnalyzer::build_process_graph(
+    const PerformanceMetrics& metrics, double quantile) {
+
+    auto graph = std::make_shared<ProcessGraph>();
+
+    for (const auto& from_pair : metrics.transition_time) {
+        graph->add_node(from_pair.first);
+        for (const auto& to_pair : from_pair.second) {
+            graph->add_edge(from_pair.first, to_pair.first, to_pair.second.quantile(quantile));
+        }
+    }
+
+    return graph;
+}
+
+void PerformanceAnalyzer::set_parallelism(unsigned threads) {
+    parallelism_ = threads;
+}
+
+CardinalityAnalyzer::CardinalityAnalyzer(unsigned precision)
+    : precision_(precision), parallelism_(1) {
+    if (precision < 4 || precision > 18) {
+        throw std::runtime_error("HyperLogLog precision must be between 4 and 18");
+    }
+}
+
+CardinalityAnalyzer::CardinalityMetrics CardinalityAnalyzer::analyze(const EventLog& log) {
+    return analyze(LogView(log));
+}
+
+CardinalityAnalyzer::CardinalityMetrics CardinalityAnalyzer::analyze(const LogView& view) {
+    PROCMINE_TRACE_SCOPE("analyze.cardinality");
+    const size_t traces = view.size();
+    const unsigned workers = static_cast<unsigned>(
+        std::max<size_t>(1, std::min<size_t>(resolve_thread_count(parallelism_), traces)));
+    std::vector<CardinalityMetrics> partials(workers);
+
+    auto sketch_for = [this](std::unordered_map<std::string, HyperLogLog>& sketches,
+                             const std::string& activity) -> HyperLogLog& {
+        auto it = sketches.find(activity);
+        if (it == sketches.end()) {
+            it = sketches.emplace(activity, HyperLogLog(precision_)).first;
+        }
+        return it->second;
+    };
+
+    auto process = [&](unsigned worker) {
+        CardinalityMetrics& local = partials[worker];
+        const size_t begin = traces * worker / workers;
+        const size_t end = traces * (worker + 1) / workers;
+
+        for (size_t t = begin; t < end; ++t) {
+            TraceView trace = view.get_trace(t);
+            const uint64_t case_hash = sketch_hash(trace.get_case_id());
+            for (size_t i = 0; i < trace.size(); ++i) {
+                const Event& event = trace[i];
+                sketch_for(local.activity_cases, event.activity).add_hash(case_hash);
+                if (!event.resource.empty()) {
+                    sketch_for(local.activity_resources, event.activity).add(event.resource);
+                }
+                if (i == 0) {
+                    continue;
+                }
+                const std::string& from = trace[i - 1].activity;
+                sketch_for(local.transition_cases[from], event.activity).add_hash(case_hash);
+                if (!event.resource.empty()) {
+                    sketch_for(local.transition_resources[from], event.activity).add(event.resource);
+                }
+            }
+        }
+    };
+
+    if (workers == 1) {
+        process(0);
+    } else {
+        run_workers(workers, process);
+    }
+
+    CardinalityMetrics metrics = std::move(partials[0]);
+    for (unsigned worker = 1; worker < workers; ++worker) {
+        merge(metrics, partials[worker]);
+    }
+    return metrics;
+}
+
+void CardinalityAnalyzer::merge(CardinalityMetrics& target, const CardinalityMetrics& source) const {
+    auto merge_sketches = [](std::unordered_map<std::string, HyperLogLog>& into,
+                             const std::unordered_map<std::string, HyperLogLog>& from) {
+        for (const auto& [activity, sketch] : from) {
+            auto it = into.find(activity);
+            if (it == into.end()) {
+                into.emplace(activity, sketch);
+            } else {
+                it->second.merge(sketch);
+            }
+        }
+    };
+
+    merge_sketches(target.activity_cases, source.activity_cases);
+    merge_sketches(target.activity_resources, source.activity_resources);
+    for (const auto& [from, targets] : source.transition_cases) {
+        merge_sketches(target.transition_cases[from], targets);
+    }
+    for (const auto& [from, targets] : source.transition_resources) {
+        merge_sketches(target.transition_resources[from], targets);
+    }
+}
+
+void CardinalityAnalyzer::set_parallelism(unsigned threads) {
+    parallelism_ = threads;
+}
+
+DFGSimplifier::DFGSimplifier(const ProcessGraph& graph, EdgeMetric metric)
+    : edge_percentage_(1.0), node_threshold_(0.0) {
+    const size_t nodes = graph.node_count();
+    names_.reserve(nodes);
+    for (Vertex v = 0; v < nodes; ++v) {
+        names_.emplace_back(graph.get_name(v));
+        index_.emplace(names_.back(), v);
+    }
+    outgoing_.resize(nodes);
+    incoming_.resize(nodes);
+
+    std::vector<double> out_sum(nodes, 0.0);
+    std::vector<double> in_sum(nodes, 0.0);
+    for (Vertex v = 0; v < nodes; ++v) {
+        for (const auto& edge : graph.out_edges(v)) {
+            if (edges_.size() >= UINT32_MAX) {
+                throw std::runtime_error("Process graph too large to simplify");
+            }
+            outgoing_[edge.from].push_back(static_cast<uint32_t>(edges_.size()));
+            incoming_[edge.to].push_back(static_cast<uint32_t>(edges_.size()));
+            out_sum[edge.from] += edge.weight;
+            in_sum[edge.to] += edge.weight;
+            edges_.push_back({edge.from, edge.to, edge.weight, edge.weight});
+        }
+    }
+
+    if (metric == EdgeMetric::Significance) {
+        for (auto& edge : edges_) {
+            double source = out_sum[edge.from] > 0 ? edge.weight / out_sum[edge.from] : 0.0;
+            double target = in_sum[edge.to] > 0 ? edge.weight / in_sum[edge.to] : 0.0;
+            edge.score = (source + target) / 2.0;
+        }
+    }
+
+    ranked_.resize(edges_.size());
+    std::iota(ranked_.begin(), ranked_.end(), 0);
+    std::stable_sort(ranked_.begin(), ranked_.end(), [this](uint32_t a, uint32_t b) {
+        return edges_[a].score > edges_[b].score;
+    });
+
+    node_significance_.resize(nodes, 0.0);
+    double max_significance = 0.0;
+    for (size_t v = 0; v < nodes; ++v) {
+        node_significance_[v] = std::max(in_sum[v], out_sum[v]);
+        max_significance = std::max(max_significance, node_significance_[v]);
+    }
+    if (max_significance > 0) {
+        for (auto& significance : node_significance_) {
+            significance /= max_significance;
+        }
+    }
+
+    is_start_.assign(nodes, 0);
+    is_end_.assign(nodes, 0);
+    for (size_t v = 0; v < nodes; ++v) {
+        is_start_[v] = incoming_[v].empty() && !outgoing_[v].empty();
+        is_end_[v] = outgoing_[v].empty() && !incoming_[v].empty();
+    }
+    if (nodes > 0 && std::find(is_start_.begin(), is_start_.end(), 1) == is_start_.end()) {
+        size_t best = 0;
+        for (size_t v = 1; v < nodes; ++v) {
+            if (out_sum[v] - in_sum[v] > out_sum[best] - in_sum[best]) {
+                best = v;
+            }
+        }
+        is_start_[best] = 1;
+    }
+    if (nodes > 0 && std::find(is_end_.begin(), is_end_.end(), 1) == is_end_.end()) {
+        size_t best = 0;
+        for (size_t v = 1; v < nodes; ++v) {
+            if (in_sum[v] - out_sum[v] > in_sum[best] - out_sum[best]) {
+                best = v;
+            }
+        }
+        is_end_[best] = 1;
+    }
+
+    compute_widest_paths();
+}
+
+void DFGSimplifier::set_edge_percentage(double fraction) {
+    edge_percentage_ = std::clamp(fraction, 0.0, 1.0);
+}
+
+void DFGSimplifier::set_node_threshold(double threshold) {
+    node_threshold_ = threshold;
+}
+
+void DFGSimplifier::set_start_activities(const std::vector<std::string>& activities) {
+    std::fill(is_start_.begin(), is_start_.end(), 0);
+    for (const auto& activity : activities) {
+        auto it = index_.find(activity);
+        if (it != index_.end()) {
+            is_start_[it->second] = 1;
+        }
+    }
+    compute_widest_paths();
+}
+
+void DFGSimplifier::set_end_activities(const std::vector<std::string>& activities) {
+    std::fill(is_end_.begin(), is_end_.end(), 0);
+    for (const auto& activity : activities) {
+        auto it = index_.find(activity);
+        if (it != index_.end()) {
+            is_end_[it->second] = 1;
+        }
+    }
+    compute_widest_paths();
+}
+
+void DFGSimplifier::compute_widest_paths() {
+    widest_paths(is_start_, true, start_parents_);
+    widest_paths(is_end_, false, end_parents_);
+}
+
+void DFGSimplifier::widest_paths(const std::vector<uint8_t>& roots, bool forward,
+                                 std::vector<uint32_t>& parents) const {
+    const size_t nodes = roots.size();
+    std::vector<double> width(nodes, -1.0);
+    parents.assign(nodes, UINT32_MAX);
+
+    using Entry = std::pair<double, Vertex>;
+    std::priority_queue<Entry> queue;
+    for (size_t v = 0; v < nodes; ++v) {
+        if (roots[v]) {
+            width[v] = INFINITY;
+            queue.emplace(INFINITY, v);
+        }
+    }
+
+    while (!queue.empty()) {
+        auto [current, v] = queue.top();
+        queue.pop();
+        if (current < width[v]) {
+            continue;
+        }
+        for (uint32_t e : forward ? outgoing_[v] : incoming_[v]) {
+            Vertex next = forward ? edges_[e].to : edges_[e].from;
+            double candidate = std::min(current, edges_[e].score);
+            if (candidate > width[next]) {
+                width[next] = candidate;
+                parents[next] = e;
+                queue.emplace(candidate, next);
+            }
+        }
+    }
+}
+
+std::shared_ptr<ProcessGraph> DFGSimplifier::simplify() const {
+    PROCMINE_TRACE_SCOPE("simplify.dfg");
+    const size_t nodes = node_significance_.size();
+    std::vector<uint8_t> keep_edge(edges_.size(), 0);
+    std::vector<uint8_t> keep_node(nodes, 0);
+
+    size_t budget = static_cast<size_t>(std::ceil(edge_percentage_ * edges_.size()));
+    for (size_t i = 0; i < budget; ++i) {
+        const auto& edge = edges_[ranked_[i]];
+        keep_edge[ranked_[i]] = 1;
+        keep_node[edge.from] = 1;
+        keep_node[edge.to] = 1;
+    }
+    for (size_t v = 0; v < nodes; ++v) {
+        if ((is_start_[v] || is_end_[v]) && !(outgoing_[v].empty() && incoming_[v].empty())) {
+            keep_node[v] = 1;
+        }
+    }
+
+    std::vector<uint8_t> reaches_start(is_start_);
+    std::vector<uint8_t> reaches_end(is_end_);
+    auto connect = [&](Vertex v, const std::vector<uint32_t>& parents,
+                       std::vector<uint8_t>& connected, bool forward) {
+        Vertex u = v;
+        while (!connected[u] && parents[u] != UINT32_MAX) {
+            u = forward ? edges_[parents[u]].from : edges_[parents[u]].to;
+        }
+        if (!connected[u]) {
+            return;
+        }
+        for (u = v; !connected[u]; u = forward ? edges_[parents[u]].from : edges_[parents[u]].to) {
+            connected[u] = 1;
+            keep_edge[parents[u]] = 1;
+            keep_node[edges_[parents[u]].from] = 1;
+            keep_node[edges_[parents[u]].to] = 1;
+        }
+    };
+
+    std::vector<Vertex> selected;
+    for (size_t v = 0; v < nodes; ++v) {
+        if (keep_node[v]) {
+            selected.push_back(v);
+        }
+    }
+    for (Vertex v : selected) {
+        connect(v, start_parents_, reaches_start, true);
+        connect(v, end_parents_, reaches_end, false);
+    }
+
+    std::vector<Vertex> cluster_root(nodes);
+    std::iota(cluster_root.begin(), cluster_root.end(), 0);
+    auto find = [&](Vertex v) {
+        while (cluster_root[v] != v) {
+            cluster_root[v] = cluster_root[cluster_root[v]];
+            v = cluster_root[v];
+        }
+        return v;
+    };
+    auto low = [&](Vertex v) {
+        return keep_node[v] && !is_start_[v] && !is_end_[v] && node_significance_[v] < node_threshold_;
+    };
+    for (const auto& edge : edges_) {
+        if (edge.from != edge.to && low(edge.from) && low(edge.to)) {
+            cluster_root[find(edge.from)] = find(edge.to);
+        }
+    }
+
+    std::vector<size_t> cluster_size(nodes, 0);
+    for (size_t v = 0; v < nodes; ++v) {
+        if (keep_node[v]) {
+            cluster_size[find(v)]++;
+        }
+    }
+
+    auto result = std::make_shared<ProcessGraph>();
+    std::vector<Vertex> mapped(nodes, ProcessGraph::npos);
+    std::vector<Vertex> cluster_vertex(nodes, ProcessGraph::npos);
+    size_t clusters = 0;
+    for (size_t v = 0; v < nodes; ++v) {
+        if (!keep_node[v]) {
+            continue;
+        }
+        Vertex root = find(v);
+        if (cluster_size[root] < 2) {
+            mapped[v] = result->add_node(names_[v]);
+            continue;
+        }
+        if (cluster_vertex[root] == ProcessGraph::npos) {
+            std::string name = "Cluster " + std::to_string(++clusters);
+            while (index_.count(name)) {
+                name = "Cluster " + std::to_string(++clusters);
+            }
+            cluster_vertex[root] = result->add_node(name);
+        }
+        mapped[v] = cluster_vertex[root];
+    }
+
+    std::unordered_map<uint64_t, size_t> merged;
+    std::vector<RankedEdge> output;
+    for (size_t e = 0; e < edges_.size(); ++e) {
+        if (!keep_edge[e]) {
+            continue;
+        }
+        Vertex from = mapped[edges_[e].from];
+        Vertex to = mapped[edges_[e].to];
+        if (from == to && edges_[e].from != edges_[e].to) {
+            continue;
+        }
+        uint64_t key = (static_cast<uint64_t>(from) << 32) ^ static_cast<uint64_t>(to);
+        auto slot = merged.try_emplace(key, output.size());
+        if (slot.second) {
+            output.push_back({from, to, edges_[e].weight, 0.0});
+        } else {
+            output[slot.first->second].weight += edges_[e].weight;
+        }
+    }
+    for (const auto& edge : output) {
+        result->add_edge(edge.from, edge.to, edge.weight);
+    }
+
+    return result;
+}
+
+ConformanceChecker::ConformanceChecker(const ProcessGraph& process_model)
+    : process_model_(&process_model), frozen_model_(nullptr) {}
+
+ConformanceChecker::ConformanceChecker(const FrozenProcessGraph& process_model)
+    : process_model_(nullptr), frozen_model_(&process_model) {}
+
+bool ConformanceChecker::has_transition(const std::string& from, const std::string& to) const {
+    if (frozen_model_) {
+        uint32_t source = frozen_model_->find_node(from);
+        uint32_t target = frozen_model_->find_node(to);
+        return source != FrozenProcessGraph::npos && target != FrozenProcessGraph::npos &&
+               frozen_model_->has_edge(source, target);
+    }
+
+    return process_model_->has_edge(from, to);
+}
+
+bool ConformanceChecker::has_activity(const std::string& activity) const {
+    if (frozen_model_) {
+        return frozen_model_->find_node(activity) != FrozenProcessGraph::npos;
+    }
+
+    return process_model_->find_node(activity) != ProcessGraph::npos;
+}
+
+ConformanceChecker::ConformanceResult ConformanceChecker::check_trace(const Trace& trace) {
+    return check_trace(TraceView(trace));
+}
+
+ConformanceChecker::ConformanceResult ConformanceChecker::check_trace(const TraceView& trace) {
+    ConformanceResult result;
+    result.total_activities = trace.size();
+    result.matched_activities = 0;
+
+    for (size_t i = 0; i + 1 < trace.size(); ++i) {
+        const std::string& from = trace[i].activity;
+        const std::string& to = trace[i + 1].activity;
+
+        if (has_transition(from, to)) {
+            result.matched_activities++;
+        } else {
+            std::string violation = "Transition from '" + from + "' to '" + to + "' not found in model";
+            result.violations.push_back(violation);
+        }
+    }
+
+    if (!trace.empty()) {
+        if (has_activity(trace[trace.size() - 1].activity)) {
+            result.matched_activities++;
+        }
+    }
+
+    if (result.total_activities > 0) {
+        result.fitness = static_cast<double>(result.matched_activities) / result.total_activities;
+    } else {
+        result.fitness = 1.0;
+    }
+    
+    return result;
+}
+
+std::vector<ConformanceChecker::ConformanceResult> ConformanceChecker::check_log(const EventLog& log) {
+    return check_log(LogView(log));
+}
+
+std::vector<ConformanceChecker::ConformanceResult> ConformanceChecker::check_log(const LogView& view) {
+    PROCMINE_TRACE_SCOPE("conformance.check_log");
+    std::vector<ConformanceResult> results;
+    
+    for (const auto& trace : view) {
+        results.push_back(check_trace(trace));
+    }
+    
+    return results;
+}
+
+double ConformanceChecker::calculate_overall_conformance(const EventLog& log) {
+    return calculate_overall_conformance(LogView(log));
+}
+
+double ConformanceChecker::calculate_overall_conformance(const LogView& view) {
+    auto results = check_log(view);
     
     double total_fitness = 0.0;
     for (const auto& result : results) {
@@ -128,8 +128,10 @@ void QueryResult::set_column_names(char** col_names, int num_cols) {
     }
 }
 
-Database::Database(const std::string& db_path) : db_(nullptr) {
-    int rc = sqlite3_open(db_path.c_str(), &db_);
+Database::Database(const std::string& db_path, bool read_only) : db_(nullptr) {
+    int flags = read_only ? SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX
+                          : SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+    int rc = sqlite3_open_v2(db_path.c_str(), &db_, flags, nullptr);
     if (rc != SQLITE_OK) {
         std::string errmsg = sqlite3_errmsg(db_);
         sqlite3_close(db_);
@@ -194,6 +196,10 @@ void Database::Statement::bind(int index, int value) {
     sqlite3_bind_int(stmt_, index, value);
 }
 
+void Database::Statement::bind(int index, int64_t value) {
+    sqlite3_bind_int64(stmt_, index, value);
+}
+
 void Database::Statement::bind(int index, double value) {
     sqlite3_bind_double(stmt_, index, value);
 }
@@ -206,6 +212,10 @@ void Database::Statement::bind(int index, std::nullptr_t) {
     sqlite3_bind_null(stmt_, index);
 }
 
+void Database::Statement::bind_static(int index, std::string_view value) {
+    sqlite3_bind_text(stmt_, index, value.data(), static_cast<int>(value.size()), SQLITE_STATIC);
+}
+
 bool Database::Statement::execute() {
     int rc = sqlite3_step(stmt_);
     sqlite3_reset(stmt_);
@@ -249,6 +259,43 @@ std::shared_ptr<QueryResult> Database::Statement::query() {
     return result;
 }
 
+bool Database::Statement::step() {
+    int rc = sqlite3_step(stmt_);
+    if (rc == SQLITE_ROW) {
+        return true;
+    }
+    if (rc != SQLITE_DONE) {
+        std::string error = sqlite3_errmsg(sqlite3_db_handle(stmt_));
+        sqlite3_reset(stmt_);
+        throw std::runtime_error("SQL error: " + error);
+    }
+    return false;
+}
+
+void Database::Statement::reset() {
+    sqlite3_reset(stmt_);
+}
+
+bool Database::Statement::column_is_null(int col) const {
+    return sqlite3_column_type(stmt_, col) == SQLITE_NULL;
+}
+
+int64_t Database::Statement::column_int64(int col) const {
+    return sqlite3_column_int64(stmt_, col);
+}
+
+double Database::Statement::column_double(int col) const {
+    return sqlite3_column_double(stmt_, col);
+}
+
+std::string_view Database::Statement::column_text(int col) const {
+    const unsigned char* text = sqlite3_column_text(stmt_, col);
+    if (text == nullptr) {
+        return std::string_view();
+    }
+    return std::string_view(reinterpret_cast<const char*>(text), sqlite3_column_bytes(stmt_, col));
+}
+
 std::shared_ptr<Database::Statement> Database::prepare(const std::string& sql) {
     sqlite3_stmt* stmt = nullptr;
     int rc = sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr);
@@ -276,6 +323,10 @@ int64_t Database::last_insert_rowid() const {
     return sqlite3_last_insert_rowid(db_);
 }
 
+int Database::get_variable_limit() const {
+    return sqlite3_limit(db_, SQLITE_LIMIT_VARIABLE_NUMBER, -1);
+}
+
 int Database::get_error_code() const {
     return sqlite3_errcode(db_);
 }
@@ -284,4 +335,14 @@ std::string Database::get_error_message() const {
     return sqlite3_errmsg(db_);
 }
 
+std::string Database::quote_identifier(const std::string& identifier) {
+    std::string quoted = "\"";
+    for (char c : identifier) {
+        if (c == '"') quoted += '"';
+        quoted += c;
+    }
+    quoted += '"';
+    return quoted;
+}
+
 }
@@ -0,0 +1,331 @@
+#include "procmine/export.h"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace procmine {
+
+namespace {
+
+constexpr char binary_magic[4] = {'P', 'M', 'G', '1'};
+constexpr size_t default_buffer_size = 64 * 1024;
+
+std::string_view format_weight(double weight, char* buffer, size_t size) {
+    int length = std::snprintf(buffer, size, "%g", weight);
+    return std::string_view(buffer, static_cast<size_t>(std::max(length, 0)));
+}
+
+}
+
+GraphWriter::GraphWriter(std::ostream& out)
+    : stream_(&out), fd_(-1), buffer_size_(default_buffer_size) {}
+
+GraphWriter::GraphWriter(int fd)
+    : stream_(nullptr), fd_(fd), buffer_size_(default_buffer_size) {}
+
+void GraphWriter::set_buffer_size(size_t bytes) {
+    buffer_size_ = std::max<size_t>(1, bytes);
+}
+
+void GraphWriter::append(std::string_view data) {
+    while (!data.empty()) {
+        size_t room = buffer_size_ - std::min(buffer_size_, buffer_.size());
+        if (room == 0) {
+            flush();
+            continue;
+        }
+        size_t chunk = std::min(room, data.size());
+        buffer_.append(data.data(), chunk);
+        data.remove_prefix(chunk);
+    }
+}
+
+void GraphWriter::append(char c) {
+    if (buffer_.size() >= buffer_size_) {
+        flush();
+    }
+    buffer_.push_back(c);
+}
+
+void GraphWriter::flush() {
+    if (stream_) {
+        stream_->write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        if (!*stream_) {
+            throw std::runtime_error("Failed to write graph output");
+        }
+    } else {
+        const char* data = buffer_.data();
+        size_t remaining = buffer_.size();
+        while (remaining > 0) {
+            ssize_t written = ::write(fd_, data, remaining);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::runtime_error("Failed to write graph output: " + std::string(std::strerror(errno)));
+            }
+            data += written;
+            remaining -= static_cast<size_t>(written);
+        }
+    }
+    buffer_.clear();
+}
+
+void DOTGraphWriter::write(const ProcessGraph& graph) {
+    char number[32];
+
+    append("digraph G {\n");
+    for (Vertex v = 0; v < graph.node_count(); ++v) {
+        auto id = std::to_chars(number, number + sizeof(number), v);
+        append(std::string_view(number, id.ptr - number));
+        append("[label=\"");
+        for (char c : graph.get_name(v)) {
+            switch (c) {
+                case '"': append("\\\""); break;
+                case '\\': append("\\\\"); break;
+                case '\n': append("\\n"); break;
+                case '\r': append("\\r"); break;
+                default: append(c); break;
+            }
+        }
+        append("\", shape=box];\n");
+    }
+
+    for (Vertex v = 0; v < graph.node_count(); ++v) {
+        for (const auto& edge : graph.out_edges(v)) {
+            auto from = std::to_chars(number, number + sizeof(number), edge.from);
+            append(std::string_view(number, from.ptr - number));
+            append("->");
+            auto to = std::to_chars(number, number + sizeof(number), edge.to);
+            append(std::string_view(number, to.ptr - number));
+            append(" [label=\"");
+            append(format_weight(edge.weight, number, sizeof(number)));
+            append("\"];\n");
+        }
+    }
+    append("}\n");
+    flush();
+}
+
+void JSONGraphWriter::write(const ProcessGraph& graph) {
+    char number[32];
+
+    append("{\"nodes\":[");
+    for (Vertex v = 0; v < graph.node_count(); ++v) {
+        if (v > 0) {
+            append(',');
+        }
+        append("{\"id\":");
+        auto id = std::to_chars(number, number + sizeof(number), v);
+        append(std::string_view(number, id.ptr - number));
+        append(",\"label\":\"");
+        for (char c : graph.get_name(v)) {
+            switch (c) {
+                case '"': append("\\\""); break;
+                case '\\': append("\\\\"); break;
+                case '\n': append("\\n"); break;
+                case '\r': append("\\r"); break;
+                case '\t': append("\\t"); break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        std::snprintf(number, sizeof(number), "\\u%04x", static_cast<unsigned>(c));
+                        append(number);
+                    } else {
+                        append(c);
+                    }
+                    break;
+            }
+        }
+        append("\"}");
+    }
+
+    append("],\"edges\":[");
+    bool first = true;
+    for (Vertex v = 0; v < graph.node_count(); ++v) {
+        for (const auto& edge : graph.out_edges(v)) {
+            append(first ? "{\"source\":" : ",{\"source\":");
+            first = false;
+            auto from = std::to_chars(number, number + sizeof(number), edge.from);
+            append(std::string_view(number, from.ptr - number));
+            append(",\"target\":");
+            auto to = std::to_chars(number, number + sizeof(number), edge.to);
+            append(std::string_view(number, to.ptr - number));
+            append(",\"weight\":");
+            if (std::isfinite(edge.weight)) {
+                auto weight = std::to_chars(number, number + sizeof(number), edge.weight);
+                append(std::string_view(number, weight.ptr - number));
+            } else {
+                append("null");
+            }
+            append('}');
+        }
+    }
+    append("]}\n");
+    flush();
+}
+
+void BinaryGraphWriter::append_u32(uint32_t value) {
+    char bytes[4];
+    for (int i = 0; i < 4; ++i) {
+        bytes[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+    append(std::string_view(bytes, sizeof(bytes)));
+}
+
+void BinaryGraphWriter::append_u64(uint64_t value) {
+    char bytes[8];
+    for (int i = 0; i < 8; ++i) {
+        bytes[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+    append(std::string_view(bytes, sizeof(bytes)));
+}
+
+void BinaryGraphWriter::write(const ProcessGraph& graph) {
+    if (graph.node_count() >= UINT32_MAX) {
+        throw std::runtime_error("Process graph too large for binary export");
+    }
+
+    append(std::string_view(binary_magic, sizeof(binary_magic)));
+    append_u64(graph.node_count());
+    for (Vertex v = 0; v < graph.node_count(); ++v) {
+        std::string_view name = graph.get_name(v);
+        if (name.size() > UINT32_MAX) {
+            throw std::runtime_error("Activity name too long for binary export");
+        }
+        append_u32(static_cast<uint32_t>(name.size()));
+        append(name);
+    }
+
+    append_u64(boost::num_edges(graph.get_graph()));
+    for (Vertex v = 0; v < graph.node_count(); ++v) {
+        for (const auto& edge : graph.out_edges(v)) {
+            uint64_t weight;
+            std::memcpy(&weight, &edge.weight, sizeof(weight));
+            append_u32(static_cast<uint32_t>(edge.from));
+            append_u32(static_cast<uint32_t>(edge.to));
+            append_u64(weight);
+        }
+    }
+    flush();
+}
+
+BinaryGraphReader::BinaryGraphReader(std::istream& in)
+    : stream_(&in), fd_(-1), position_(0) {}
+
+BinaryGraphReader::BinaryGraphReader(int fd)
+    : stream_(nullptr), fd_(fd), position_(0) {}
+
+void BinaryGraphReader::read_exact(char* data, size_t size) {
+    if (stream_) {
+        stream_->read(data, static_cast<std::streamsize>(size));
+        if (static_cast<size_t>(stream_->gcount()) != size) {
+            throw std::runtime_error("Unexpected end of graph data");
+        }
+        return;
+    }
+
+    while (size > 0) {
+        if (position_ == buffer_.size()) {
+            buffer_.resize(default_buffer_size);
+            ssize_t count;
+            do {
+                count = ::read(fd_, buffer_.data(), buffer_.size());
+            } while (count < 0 && errno == EINTR);
+            if (count < 0) {
+                throw std::runtime_error("Failed to read graph data: " + std::string(std::strerror(errno)));
+            }
+            size_t filled = static_cast<size_t>(count);
+            buffer_.resize(filled);
+            position_ = 0;
+            if (filled == 0) {
+                throw std::runtime_error("Unexpected end of graph data");
+            }
+        }
+
+        size_t chunk = std::min(size, buffer_.size() - position_);
+        std::memcpy(data, buffer_.data() + position_, chunk);
+        position_ += chunk;
+        data += chunk;
+        size -= chunk;
+    }
+}
+
+void BinaryGraphReader::read_string(std::string& out, size_t size) {
+    out.clear();
+    while (out.size() < size) {
+        size_t offset = out.size();
+        size_t chunk = std::min(default_buffer_size, size - offset);
+        out.resize(offset + chunk);
+        read_exact(out.data() + offset, chunk);
+    }
+}
+
+void BinaryGraphReader::release_surplus() {
+    size_t surplus = buffer_.size() - position_;
+    if (fd_ >= 0 && surplus > 0 && ::lseek(fd_, -static_cast<off_t>(surplus), SEEK_CUR) != -1) {
+        buffer_.clear();
+        position_ = 0;
+    }
+}
+
+uint32_t BinaryGraphReader::read_u32() {
+    unsigned char bytes[4];
+    read_exact(reinterpret_cast<char*>(bytes), sizeof(bytes));
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        value |= static_cast<uint32_t>(bytes[i]) << (8 * i);
+    }
+    return value;
+}
+
+uint64_t BinaryGraphReader::read_u64() {
+    unsigned char bytes[8];
+    read_exact(reinterpret_cast<char*>(bytes), sizeof(bytes));
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) {
+        value |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+    }
+    return value;
+}
+
+std::shared_ptr<ProcessGraph> BinaryGraphReader::read() {
+    char magic[sizeof(binary_magic)];
+    read_exact(magic, sizeof(magic));
+    if (std::memcmp(magic, binary_magic, sizeof(magic)) != 0) {
+        throw std::runtime_error("Not a binary process graph");
+    }
+
+    auto graph = std::make_shared<ProcessGraph>();
+
+    uint64_t nodes = read_u64();
+    std::string name;
+    for (uint64_t i = 0; i < nodes; ++i) {
+        read_string(name, read_u32());
+        if (graph->add_node(name) != i) {
+            throw std::runtime_error("Duplicate activity in graph data: " + name);
+        }
+    }
+
+    uint64_t edges = read_u64();
+    for (uint64_t i = 0; i < edges; ++i) {
+        uint32_t from = read_u32();
+        uint32_t to = read_u32();
+        uint64_t bits = read_u64();
+        if (from >= nodes || to >= nodes) {
+            throw std::runtime_error("Edge references unknown node in graph data");
+        }
+        double weight;
+        std::memcpy(&weight, &bits, sizeof(weight));
+        graph->add_edge(static_cast<Vertex>(from), static_cast<Vertex>(to), weight);
+    }
+
+    release_surplus();
+    return graph;
+}
+
+}
@@ -0,0 +1,651 @@
+#include "procmine/filter.h"
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+namespace procmine {
+
+namespace {
+
+constexpr uint32_t array_limit = 4096;
+constexpr size_t bitset_words = 1024;
+
+uint32_t count_bits(const std::vector<uint64_t>& words) {
+    uint32_t count = 0;
+    for (uint64_t word : words) {
+        count += static_cast<uint32_t>(__builtin_popcountll(word));
+    }
+    return count;
+}
+
+}
+
+bool Bitmap::Container::contains(uint16_t low) const {
+    if (words.empty()) {
+        return std::binary_search(array.begin(), array.end(), low);
+    }
+    return (words[low >> 6] >> (low & 63)) & 1;
+}
+
+void Bitmap::Container::to_bitset() {
+    if (!words.empty()) {
+        return;
+    }
+    words.assign(bitset_words, 0);
+    for (uint16_t low : array) {
+        words[low >> 6] |= uint64_t(1) << (low & 63);
+    }
+    array.clear();
+    array.shrink_to_fit();
+}
+
+void Bitmap::Container::normalize() {
+    if (words.empty()) {
+        if (array.size() > array_limit) {
+            to_bitset();
+        }
+        return;
+    }
+    if (cardinality > array_limit) {
+        return;
+    }
+    array.clear();
+    array.reserve(cardinality);
+    for (size_t w = 0; w < words.size(); ++w) {
+        uint64_t word = words[w];
+        while (word != 0) {
+            array.push_back(static_cast<uint16_t>(w * 64 + __builtin_ctzll(word)));
+            word &= word - 1;
+        }
+    }
+    words.clear();
+    words.shrink_to_fit();
+}
+
+Bitmap::Bitmap() {}
+
+Bitmap Bitmap::range(uint32_t begin, uint32_t end) {
+    Bitmap result;
+    result.add_range(begin, end);
+    return result;
+}
+
+Bitmap::Container& Bitmap::container_for(uint16_t key) {
+    if (!containers_.empty() && containers_.back().key == key) {
+        return containers_.back();
+    }
+
+    auto it = std::lower_bound(containers_.begin(), containers_.end(), key,
+                               [](const Container& c, uint16_t k) { return c.key < k; });
+    if (it == containers_.end() || it->key != key) {
+        Container container;
+        container.key = key;
+        it = containers_.insert(it, std::move(container));
+    }
+    return *it;
+}
+
+void Bitmap::add(uint32_t value) {
+    Container& container = container_for(static_cast<uint16_t>(value >> 16));
+    uint16_t low = static_cast<uint16_t>(value & 0xFFFF);
+
+    if (!container.words.empty()) {
+        uint64_t mask = uint64_t(1) << (low & 63);
+        if (!(container.words[low >> 6] & mask)) {
+            container.words[low >> 6] |= mask;
+            container.cardinality++;
+        }
+        return;
+    }
+
+    if (container.array.empty() || container.array.back() < low) {
+        container.array.push_back(low);
+    } else {
+        auto it = std::lower_bound(container.array.begin(), container.array.end(), low);
+        if (it != container.array.end() && *it == low) {
+            return;
+        }
+        container.array.insert(it, low);
+    }
+    container.cardinality++;
+    container.normalize();
+}
+
+void Bitmap::add_range(uint32_t begin, uint32_t end) {
+    if (begin >= end) {
+        return;
+    }
+
+    uint64_t value = begin;
+    while (value < end) {
+        uint16_t key = static_cast<uint16_t>(value >> 16);
+        uint64_t chunk_end = std::min<uint64_t>(end, (uint64_t(key) + 1) << 16);
+        uint32_t first = static_cast<uint32_t>(value & 0xFFFF);
+        uint32_t last = static_cast<uint32_t>(chunk_end - (uint64_t(key) << 16));
+
+        Container& container = container_for(key);
+        container.to_bitset();
+        for (uint32_t bit = first; bit < last;) {
+            uint32_t word = bit >> 6;
+            uint32_t offset = bit & 63;
+            uint32_t span = std::min<uint32_t>(64 - offset, last - bit);
+            uint64_t mask = span == 64 ? ~uint64_t(0) : ((uint64_t(1) << span) - 1) << offset;
+            container.words[word] |= mask;
+            bit += span;
+        }
+        container.cardinality = count_bits(container.words);
+        container.normalize();
+
+        value = chunk_end;
+    }
+}
+
+bool Bitmap::contains(uint32_t value) const {
+    uint16_t key = static_cast<uint16_t>(value >> 16);
+    auto it = std::lower_bound(containers_.begin(), containers_.end(), key,
+                               [](const Container& c, uint16_t k) { return c.key < k; });
+    return it != containers_.end() && it->key == key && it->contains(static_cast<uint16_t>(value & 0xFFFF));
+}
+
+uint64_t Bitmap::cardinality() const {
+    uint64_t total = 0;
+    for (const auto& container : containers_) {
+        total += container.cardinality;
+    }
+    return total;
+}
+
+bool Bitmap::empty() const {
+    return containers_.empty();
+}
+
+Bitmap::Container Bitmap::intersect(const Container& a, const Container& b) {
+    Container result;
+    result.key = a.key;
+
+    if (a.words.empty() && b.words.empty()) {
+        std::set_intersection(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(),
+                              std::back_inserter(result.array));
+        result.cardinality = static_cast<uint32_t>(result.array.size());
+        return result;
+    }
+
+    if (a.words.empty() || b.words.empty()) {
+        const Container& small = a.words.empty() ? a : b;
+        const Container& large = a.words.empty() ? b : a;
+        for (uint16_t low : small.array) {
+            if (large.contains(low)) {
+                result.array.push_back(low);
+            }
+        }
+        result.cardinality = static_cast<uint32_t>(result.array.size());
+        return result;
+    }
+
+    result.words.resize(bitset_words);
+    for (size_t w = 0; w < bitset_words; ++w) {
+        result.words[w] = a.words[w] & b.words[w];
+    }
+    result.cardinality = count_bits(result.words);
+    result.normalize();
+    return result;
+}
+
+Bitmap::Container Bitmap::unite(const Container& a, const Container& b) {
+    Container result;
+    result.key = a.key;
+
+    if (a.words.empty() && b.words.empty()) {
+        std::set_union(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(),
+                       std::back_inserter(result.array));
+        result.cardinality = static_cast<uint32_t>(result.array.size());
+        result.normalize();
+        return result;
+    }
+
+    result = a.words.empty() ? b : a;
+    result.key = a.key;
+    const Container& other = a.words.empty() ? a : b;
+    if (other.words.empty()) {
+        for (uint16_t low : other.array) {
+            result.words[low >> 6] |= uint64_t(1) << (low & 63);
+        }
+    } else {
+        for (size_t w = 0; w < bitset_words; ++w) {
+            result.words[w] |= other.words[w];
+        }
+    }
+    result.cardinality = count_bits(result.words);
+    return result;
+}
+
+Bitmap::Container Bitmap::subtract(const Container& a, const Container& b) {
+    Container result;
+    result.key = a.key;
+
+    if (a.words.empty()) {
+        for (uint16_t low : a.array) {
+            if (!b.contains(low)) {
+                result.array.push_back(low);
+            }
+        }
+        result.cardinality = static_cast<uint32_t>(result.array.size());
+        return result;
+    }
+
+    result.words = a.words;
+    if (b.words.empty()) {
+        for (uint16_t low : b.array) {
+            result.words[low >> 6] &= ~(uint64_t(1) << (low & 63));
+        }
+    } else {
+        for (size_t w = 0; w < bitset_words; ++w) {
+            result.words[w] &= ~b.words[w];
+        }
+    }
+    result.cardinality = count_bits(result.words);
+    result.normalize();
+    return result;
+}
+
+Bitmap Bitmap::operator&(const Bitmap& other) const {
+    Bitmap result;
+    auto a = containers_.begin();
+    auto b = other.containers_.begin();
+    while (a != containers_.end() && b != other.containers_.end()) {
+        if (a->key < b->key) {
+            ++a;
+        } else if (b->key < a->key) {
+            ++b;
+        } else {
+            Container container = intersect(*a, *b);
+            if (container.cardinality > 0) {
+                result.containers_.push_back(std::move(container));
+            }
+            ++a;
+            ++b;
+        }
+    }
+    return result;
+}
+
+Bitmap Bitmap::operator|(const Bitmap& other) const {
+    Bitmap result;
+    auto a = containers_.begin();
+    auto b = other.containers_.begin();
+    while (a != containers_.end() || b != other.containers_.end()) {
+        if (b == other.containers_.end() || (a != containers_.end() && a->key < b->key)) {
+            result.containers_.push_back(*a++);
+        } else if (a == containers_.end() || b->key < a->key) {
+            result.containers_.push_back(*b++);
+        } else {
+            result.containers_.push_back(unite(*a, *b));
+            ++a;
+            ++b;
+        }
+    }
+    return result;
+}
+
+Bitmap Bitmap::and_not(const Bitmap& other) const {
+    Bitmap result;
+    auto b = other.containers_.begin();
+    for (const auto& container : containers_) {
+        while (b != other.containers_.end() && b->key < container.key) {
+            ++b;
+        }
+        if (b == other.containers_.end() || b->key != container.key) {
+            result.containers_.push_back(container);
+            continue;
+        }
+        Container remaining = subtract(container, *b);
+        if (remaining.cardinality > 0) {
+            result.containers_.push_back(std::move(remaining));
+        }
+    }
+    return result;
+}
+
+std::vector<uint32_t> Bitmap::to_vector() const {
+    std::vector<uint32_t> values;
+    values.reserve(cardinality());
+    for_each([&values](uint32_t value) { values.push_back(value); });
+    return values;
+}
+
+Predicate::Predicate(std::shared_ptr<const Node> node) : node_(std::move(node)) {}
+
+Predicate Predicate::activity(const std::string& activity) {
+    auto node = std::make_shared<Node>();
+    node->kind = Kind::Activity;
+    node->values = {activity};
+    return Predicate(node);
+}
+
+Predicate Predicate::resource(const std::string& resource) {
+    auto node = std::make_shared<Node>();
+    node->kind = Kind::Resource;
+    node->values = {resource};
+    return Predicate(node);
+}
+
+Predicate Predicate::attribute(const std::string& name, const std::string& value) {
+    auto node = std::make_shared<Node>();
+    node->kind = Kind::Attribute;
+    node->values = {name, value};
+    return Predicate(node);
+}
+
+Predicate Predicate::case_id(const std::string& case_id) {
+    auto node = std::make_shared<Node>();
+    node->kind = Kind::CaseId;
+    node->values = {case_id};
+    return Predicate(node);
+}
+
+Predicate Predicate::trace_length(size_t min_length, size_t max_length) {
+    auto node = std::make_shared<Node>();
+    node->kind = Kind::TraceLength;
+    node->min_length = min_length;
+    node->max_length = max_length;
+    return Predicate(node);
+}
+
+Predicate Predicate::variant(const std::vector<std::string>& activities) {
+    auto node = std::make_shared<Node>();
+    node->kind = Kind::Variant;
+    node->values = activities;
+    return Predicate(node);
+}
+
+Predicate Predicate::eventually_follows(const std::string& first, const std::string& second) {
+    auto node = std::make_shared<Node>();
+    node->kind = Kind::EventuallyFollows;
+    node->values = {first, second};
+    return Predicate(node);
+}
+
+Predicate Predicate::operator&&(const Predicate& other) const {
+    auto node = std::make_shared<Node>();
+    node->kind = Kind::And;
+    node->children = {node_, other.node_};
+    return Predicate(node);
+}
+
+Predicate Predicate::operator||(const Predicate& other) const {
+    auto node = std::make_shared<Node>();
+    node->kind = Kind::Or;
+    node->children = {node_, other.node_};
+    return Predicate(node);
+}
+
+Predicate Predicate::operator!() const {
+    auto node = std::make_shared<Node>();
+    node->kind = Kind::Not;
+    node->children = {node_};
+    return Predicate(node);
+}
+
+Predicate::Kind Predicate::get_kind() const {
+    return node_->kind;
+}
+
+bool Predicate::is_trace_level() const {
+    switch (node_->kind) {
+        case Kind::CaseId:
+        case Kind::TraceLength:
+        case Kind::Variant:
+        case Kind::EventuallyFollows:
+            return true;
+        case Kind::And:
+        case Kind::Or:
+        case Kind::Not:
+            return std::all_of(node_->children.begin(), node_->children.end(),
+                               [](const auto& child) { return Predicate(child).is_trace_level(); });
+        default:
+            return false;
+    }
+}
+
+FilterEngine::FilterEngine(const EventLog& log) : log_(log) {
+    const auto& traces = log.get_traces();
+    offsets_.reserve(traces.size() + 1);
+    offsets_.push_back(0);
+
+    uint64_t total = 0;
+    for (const auto& trace : traces) {
+        total += trace.get_events().size();
+        if (total > UINT32_MAX) {
+            throw std::runtime_error("Event log too large for 32-bit event bitmaps");
+        }
+        offsets_.push_back(static_cast<uint32_t>(total));
+    }
+
+    uint32_t event_id = 0;
+    for (const auto& trace : traces) {
+        for (const auto& event : trace.get_events()) {
+            activities_[event.activity].add(event_id);
+            resources_[event.resource].add(event_id);
+            ++event_id;
+        }
+    }
+}
+
+const EventLog& FilterEngine::get_log() const {
+    return log_;
+}
+
+size_t FilterEngine::event_count() const {
+    return offsets_.back();
+}
+
+const Bitmap& FilterEngine::activity_events(const std::string& activity) const {
+    auto it = activities_.find(activity);
+    return it == activities_.end() ? empty_ : it->second;
+}
+
+const Bitmap& FilterEngine::resource_events(const std::string& resource) const {
+    auto it = resources_.find(resource);
+    return it == resources_.end() ? empty_ : it->second;
+}
+
+Bitmap FilterEngine::evaluate(const Predicate& predicate) const {
+    return evaluate(*predicate.node_);
+}
+
+Bitmap FilterEngine::matching_traces(const Predicate& predicate) const {
+    return events_to_traces(evaluate(predicate));
+}
+
+Bitmap FilterEngine::evaluate(const Predicate::Node& node) const {
+    using Kind = Predicate::Kind;
+    const auto& traces = log_.get_traces();
+
+    switch (node.kind) {
+        case Kind::Activity:
+            return activity_events(node.values[0]);
+        case Kind::Resource:
+            return resource_events(node.values[0]);
+        case Kind::Attribute: {
+            const auto& schema = log_.get_attribute_schema();
+            const AttributeColumn* column = schema ? schema->find_column(node.values[0]) : nullptr;
+            std::vector<uint8_t> rows;
+            if (column != nullptr) {
+                rows = column->equals(node.values[1]);
+            }
+
+            Bitmap result;
+            uint32_t event_id = 0;
+            for (const auto& trace : traces) {
+                for (const auto& event : trace.get_events()) {
+                    auto it = event.attributes.find(node.values[0]);
+                    if (it != event.attributes.end()) {
+                        if (it->second == node.values[1]) {
+                            result.add(event_id);
+                        }
+                    } else if (event.attribute_row < rows.size() && rows[event.attribute_row]) {
+                        result.add(event_id);
+                    }
+                    ++event_id;
+                }
+            }
+            return result;
+        }
+        case Kind::And: {
+            Bitmap result = evaluate(*node.children[0]);
+            for (size_t i = 1; i < node.children.size() && !result.empty(); ++i) {
+                result = result & evaluate(*node.children[i]);
+            }
+            return result;
+        }
+        case Kind::Or: {
+            Bitmap result = evaluate(*node.children[0]);
+            for (size_t i = 1; i < node.children.size(); ++i) {
+                result = result | evaluate(*node.children[i]);
+            }
+            return result;
+        }
+        case Kind::Not:
+            return Bitmap::range(0, offsets_.back()).and_not(evaluate(*node.children[0]));
+        default:
+            return traces_to_events(evaluate_traces(node));
+    }
+}
+
+Bitmap FilterEngine::evaluate_traces(const Predicate::Node& node) const {
+    using Kind = Predicate::Kind;
+    const auto& traces = log_.get_traces();
+    Bitmap result;
+
+    switch (node.kind) {
+        case Kind::CaseId:
+            for (size_t t = 0; t < traces.size(); ++t) {
+                if (traces[t].get_case_id() == node.values[0]) {
+                    result.add(static_cast<uint32_t>(t));
+                }
+            }
+            break;
+        case Kind::TraceLength:
+            for (size_t t = 0; t < traces.size(); ++t) {
+                size_t length = offsets_[t + 1] - offsets_[t];
+                if (length >= node.min_length && length <= node.max_length) {
+                    result.add(static_cast<uint32_t>(t));
+                }
+            }
+            break;
+        case Kind::Variant: {
+            Bitmap candidates = Bitmap::range(0, static_cast<uint32_t>(traces.size()));
+            for (const auto& activity : node.values) {
+                candidates = candidates & events_to_traces(activity_events(activity));
+            }
+            if (node.values.empty()) {
+                candidates = Bitmap();
+                for (size_t t = 0; t < traces.size(); ++t) {
+                    if (offsets_[t + 1] == offsets_[t]) {
+                        candidates.add(static_cast<uint32_t>(t));
+                    }
+                }
+            }
+            candidates.for_each([&](uint32_t t) {
+                const auto& events = traces[t].get_events();
+                if (events.size() != node.values.size()) {
+                    return;
+                }
+                for (size_t i = 0; i < events.size(); ++i) {
+                    if (events[i].activity != node.values[i]) {
+                        return;
+                    }
+                }
+                result.add(t);
+            });
+            break;
+        }
+        case Kind::EventuallyFollows: {
+            Bitmap candidates = events_to_traces(activity_events(node.values[0]))
+                              & events_to_traces(activity_events(node.values[1]));
+            candidates.for_each([&](uint32_t t) {
+                bool seen_first = false;
+                for (const auto& event : traces[t].get_events()) {
+                    if (seen_first && event.activity == node.values[1]) {
+                        result.add(t);
+                        return;
+                    }
+                    if (event.activity == node.values[0]) {
+                        seen_first = true;
+                    }
+                }
+            });
+            break;
+        }
+        default:
+            throw std::logic_error("Predicate is not trace-level");
+    }
+
+    return result;
+}
+
+Bitmap FilterEngine::traces_to_events(const Bitmap& traces) const {
+    Bitmap result;
+    traces.for_each([&](uint32_t t) {
+        result.add_range(offsets_[t], offsets_[t + 1]);
+    });
+    return result;
+}
+
+Bitmap FilterEngine::events_to_traces(const Bitmap& events) const {
+    Bitmap result;
+    size_t trace = 0;
+    events.for_each([&](uint32_t event) {
+        while (offsets_[trace + 1] <= event) {
+            ++trace;
+        }
+        result.add(static_cast<uint32_t>(trace));
+    });
+    return result;
+}
+
+LogView FilterEngine::select_events(const Predicate& predicate) const {
+    Bitmap events = evaluate(predicate);
+
+    std::vector<size_t> trace_indexes;
+    std::vector<std::shared_ptr<const std::vector<uint32_t>>> selections;
+    std::vector<uint32_t> selection;
+    size_t trace = 0;
+    bool open = false;
+
+    auto close_trace = [&] {
+        if (!open) {
+            return;
+        }
+        trace_indexes.push_back(trace);
+        if (selection.size() == offsets_[trace + 1] - offsets_[trace]) {
+            selections.push_back(nullptr);
+        } else {
+            selections.push_back(std::make_shared<const std::vector<uint32_t>>(selection));
+        }
+        selection.clear();
+        open = false;
+    };
+
+    events.for_each([&](uint32_t event) {
+        if (offsets_[trace + 1] <= event) {
+            close_trace();
+            while (offsets_[trace + 1] <= event) {
+                ++trace;
+            }
+        }
+        selection.push_back(event - offsets_[trace]);
+        open = true;
+    });
+    close_trace();
+
+    return LogView::from_selection(log_, std::move(trace_indexes), std::move(selections));
+}
+
+LogView FilterEngine::select_traces(const Predicate& predicate) const {
+    std::vector<size_t> trace_indexes;
+    matching_traces(predicate).for_each([&](uint32_t t) { trace_indexes.push_back(t); });
+    return LogView::from_selection(log_, std::move(trace_indexes), {});
+}
+
+}
@@ -0,0 +1,331 @@
+#include "procmine/generator.h"
+#include "procmine/concurrency.h"
+#include "procmine/log.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace procmine {
+
+namespace {
+
+uint64_t case_seed(uint64_t seed, size_t case_index) {
+    uint64_t x = seed ^ (static_cast<uint64_t>(case_index) * 0x9E3779B97F4A7C15ULL);
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+void check_probability(double probability) {
+    if (!(probability >= 0.0 && probability <= 1.0)) {
+        throw std::runtime_error("Probability must be between 0 and 1");
+    }
+}
+
+}
+
+LogGenerator::LogGenerator(const ProcessGraph& model)
+    : end_probability_(0.5), noise_(0.0), max_trace_length_(256),
+      start_time_(std::chrono::system_clock::from_time_t(1704067200)),
+      case_interval_(60.0), resources_(0), seed_(0), parallelism_(1), batch_size_(65536) {
+    const size_t nodes = model.node_count();
+    if (nodes == 0) {
+        throw std::runtime_error("Cannot generate a log from an empty process model");
+    }
+
+    std::vector<uint8_t> has_incoming(nodes, 0);
+    choices_.resize(nodes);
+    for (Vertex v = 0; v < nodes; ++v) {
+        names_.emplace_back(model.get_name(v));
+        ids_.emplace(names_.back(), static_cast<uint32_t>(v));
+        for (const auto& edge : model.out_edges(v)) {
+            if (edge.weight > 0.0) {
+                choices_[v].push_back({static_cast<uint32_t>(edge.to), edge.weight});
+                has_incoming[edge.to] = 1;
+            }
+        }
+    }
+
+    for (uint32_t v = 0; v < nodes; ++v) {
+        if (!has_incoming[v]) {
+            starts_.push_back(v);
+        }
+    }
+    if (starts_.empty()) {
+        starts_.push_back(0);
+    }
+
+    is_end_.assign(nodes, 0);
+    bool any_end = false;
+    for (uint32_t v = 0; v < nodes; ++v) {
+        if (choices_[v].empty()) {
+            is_end_[v] = 1;
+            any_end = true;
+        }
+    }
+    if (!any_end) {
+        std::fill(is_end_.begin(), is_end_.end(), 1);
+    }
+
+    durations_.assign(nodes, {60.0, 30.0});
+}
+
+uint32_t LogGenerator::node_id(const std::string& activity) const {
+    auto it = ids_.find(activity);
+    if (it == ids_.end()) {
+        throw std::runtime_error("Activity not in process model: " + activity);
+    }
+    return it->second;
+}
+
+void LogGenerator::set_start_activities(const std::vector<std::string>& activities) {
+    std::vector<uint32_t> starts;
+    for (const auto& activity : activities) {
+        starts.push_back(node_id(activity));
+    }
+    if (starts.empty()) {
+        throw std::runtime_error("At least one start activity is required");
+    }
+    starts_ = std::move(starts);
+}
+
+void LogGenerator::set_end_activities(const std::vector<std::string>& activities) {
+    std::vector<uint8_t> ends(names_.size(), 0);
+    for (const auto& activity : activities) {
+        ends[node_id(activity)] = 1;
+    }
+    is_end_ = std::move(ends);
+}
+
+void LogGenerator::set_end_probability(double probability) {
+    check_probability(probability);
+    end_probability_ = probability;
+}
+
+void LogGenerator::set_loop_probability(double probability) {
+    check_probability(probability);
+    loop_probability_ = probability;
+}
+
+void LogGenerator::set_noise(double probability) {
+    check_probability(probability);
+    noise_ = probability;
+}
+
+void LogGenerator::set_max_trace_length(size_t length) {
+    max_trace_length_ = std::max<size_t>(1, length);
+}
+
+void LogGenerator::set_duration(const std::string& activity, double mean_seconds, double stddev_seconds) {
+    if (mean_seconds < 0.0 || stddev_seconds < 0.0) {
+        throw std::runtime_error("Durations must not be negative");
+    }
+    durations_[node_id(activity)] = {mean_seconds, stddev_seconds};
+}
+
+void LogGenerator::set_default_duration(double mean_seconds, double stddev_seconds) {
+    if (mean_seconds < 0.0 || stddev_seconds < 0.0) {
+        throw std::runtime_error("Durations must not be negative");
+    }
+    std::fill(durations_.begin(), durations_.end(), Duration{mean_seconds, stddev_seconds});
+}
+
+void LogGenerator::set_start_time(std::chrono::system_clock::time_point start) {
+    start_time_ = start;
+}
+
+void LogGenerator::set_case_interval(double seconds) {
+    case_interval_ = seconds;
+}
+
+void LogGenerator::set_resource_count(size_t resources) {
+    resources_ = resources;
+}
+
+void LogGenerator::set_seed(uint64_t seed) {
+    seed_ = seed;
+}
+
+void LogGenerator::set_parallelism(unsigned threads) {
+    parallelism_ = threads;
+}
+
+void LogGenerator::set_batch_size(size_t traces) {
+    batch_size_ = std::max<size_t>(1, traces);
+}
+
+double LogGenerator::sample_duration(uint32_t activity, std::mt19937_64& random) const {
+    const Duration& duration = durations_[activity];
+    if (duration.stddev == 0.0 || duration.mean == 0.0) {
+        return duration.mean;
+    }
+    double variance = std::log(1.0 + (duration.stddev * duration.stddev) / (duration.mean * duration.mean));
+    double mu = std::log(duration.mean) - variance / 2.0;
+    return std::lognormal_distribution<double>(mu, std::sqrt(variance))(random);
+}
+
+uint32_t LogGenerator::pick(const std::vector<Choice>& choices, double total, std::mt19937_64& random) const {
+    double point = std::uniform_real_distribution<double>(0.0, total)(random);
+    for (const auto& choice : choices) {
+        if (point < choice.weight) {
+            return choice.target;
+        }
+        point -= choice.weight;
+    }
+    return choices.back().target;
+}
+
+Trace LogGenerator::play_out(size_t case_index, std::vector<uint64_t>& visited,
+                             const Trace::allocator_type& allocator) const {
+    std::mt19937_64 random(case_seed(seed_, case_index));
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    const uint64_t stamp = static_cast<uint64_t>(case_index) + 1;
+
+    std::vector<uint32_t> path;
+    uint32_t current = starts_[random() % starts_.size()];
+    std::vector<Choice> back;
+    std::vector<Choice> forward;
+
+    for (;;) {
+        path.push_back(current);
+        visited[current] = stamp;
+        const auto& choices = choices_[current];
+        if (path.size() >= max_trace_length_ || choices.empty()) {
+            break;
+        }
+        if (is_end_[current] && unit(random) < end_probability_) {
+            break;
+        }
+
+        if (!loop_probability_) {
+            double total = 0.0;
+            for (const auto& choice : choices) {
+                total += choice.weight;
+            }
+            current = pick(choices, total, random);
+            continue;
+        }
+
+        back.clear();
+        forward.clear();
+        double back_total = 0.0;
+        double forward_total = 0.0;
+        for (const auto& choice : choices) {
+            if (visited[choice.target] == stamp) {
+                back.push_back(choice);
+                back_total += choice.weight;
+            } else {
+                forward.push_back(choice);
+                forward_total += choice.weight;
+            }
+        }
+        bool loop = forward.empty() || (!back.empty() && unit(random) < *loop_probability_);
+        current = loop ? pick(back, back_total, random) : pick(forward, forward_total, random);
+    }
+
+    if (noise_ > 0.0) {
+        std::vector<uint32_t> noisy;
+        noisy.reserve(path.size() + 4);
+        for (size_t i = 0; i < path.size(); ++i) {
+            if (unit(random) >= noise_) {
+                noisy.push_back(path[i]);
+                continue;
+            }
+            switch (random() % 3) {
+                case 0:
+                    break;
+                case 1:
+                    noisy.push_back(static_cast<uint32_t>(random() % names_.size()));
+                    noisy.push_back(path[i]);
+                    break;
+                default:
+                    if (i + 1 < path.size()) {
+                        noisy.push_back(path[i + 1]);
+                        noisy.push_back(path[i]);
+                        ++i;
+                    } else {
+                        noisy.push_back(path[i]);
+                    }
+                    break;
+            }
+        }
+        path = std::move(noisy);
+    }
+
+    Trace trace("case" + std::to_string(case_index), allocator);
+    trace.reserve(path.size());
+    auto time = start_time_ + std::chrono::duration_cast<std::chrono::system_clock::duration>(
+        std::chrono::duration<double>(case_interval_ * static_cast<double>(case_index)));
+
+    for (uint32_t activity : path) {
+        time += std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::duration<double>(sample_duration(activity, random)));
+        Event event(allocator);
+        event.activity = names_[activity];
+        event.timestamp = time;
+        if (resources_ > 0) {
+            event.resource = "resource" + std::to_string(random() % resources_);
+        }
+        trace.add_event(std::move(event));
+    }
+    return trace;
+}
+
+std::shared_ptr<EventLog> LogGenerator::generate(size_t traces, size_t first_case) const {
+    auto log = std::make_shared<EventLog>();
+    log->use_arena();
+
+    const unsigned workers = static_cast<unsigned>(
+        std::max<size_t>(1, std::min<size_t>(resolve_thread_count(parallelism_), traces)));
+    std::vector<Trace::allocator_type> allocators;
+    for (unsigned worker = 0; worker < workers; ++worker) {
+        allocators.emplace_back(workers == 1 ? log->get_allocator() : log->create_arena());
+    }
+    std::vector<std::vector<Trace>> partials(workers);
+
+    auto process = [&](unsigned worker) {
+        const size_t begin = traces * worker / workers;
+        const size_t end = traces * (worker + 1) / workers;
+        std::vector<uint64_t> visited(names_.size(), 0);
+        partials[worker].reserve(end - begin);
+        for (size_t t = begin; t < end; ++t) {
+            partials[worker].push_back(play_out(first_case + t, visited, allocators[worker]));
+        }
+    };
+
+    if (workers == 1) {
+        process(0);
+    } else {
+        run_workers(workers, process);
+    }
+
+    for (auto& partial : partials) {
+        for (auto& trace : partial) {
+            log->add_trace(std::move(trace));
+        }
+    }
+    return log;
+}
+
+void LogGenerator::write_csv(const std::string& filepath, size_t traces, char delimiter) const {
+    CSVLogWriter writer(filepath, delimiter);
+    writer.set_parallelism(parallelism_);
+
+    size_t first = 0;
+    do {
+        writer.write(*generate(std::min(batch_size_, traces - first), first));
+        writer.set_append_mode(true);
+        first += batch_size_;
+    } while (first < traces);
+}
+
+void LogGenerator::write_sqlite(const std::string& db_path, const std::string& table_name, size_t traces) const {
+    SQLiteLogWriter writer(db_path, table_name);
+    writer.set_bulk_mode(true);
+
+    for (size_t first = 0; first < traces; first += batch_size_) {
+        writer.write(*generate(std::min(batch_size_, traces - first), first));
+    }
+}
+
+}
@@ -0,0 +1,189 @@
+#include "procmine/instrumentation.h"
+#include <cstdio>
+#include <stdexcept>
+
+namespace procmine {
+
+namespace {
+
+void write_json_string(std::ostream& out, std::string_view value) {
+    out << '"';
+    for (char c : value) {
+        switch (c) {
+            case '"': out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                    out << escaped;
+                } else {
+                    out << c;
+                }
+                break;
+        }
+    }
+    out << '"';
+}
+
+class CountingResource : public std::pmr::memory_resource {
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        Instrumentation& instrumentation = Instrumentation::instance();
+        if (instrumentation.is_enabled()) {
+            instrumentation.add_counter("memory.arena_allocations", 1);
+            instrumentation.add_counter("memory.arena_bytes", static_cast<int64_t>(bytes));
+        }
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+}
+
+Instrumentation::Instrumentation() : enabled_(PROCMINE_INSTRUMENTATION != 0), origin_(Clock::now()) {}
+
+Instrumentation& Instrumentation::instance() {
+    static Instrumentation instrumentation;
+    return instrumentation;
+}
+
+void Instrumentation::set_enabled(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+bool Instrumentation::is_enabled() const {
+    return enabled_.load(std::memory_order_relaxed);
+}
+
+uint32_t Instrumentation::thread_index() {
+    return threads_.try_emplace(std::this_thread::get_id(), static_cast<uint32_t>(threads_.size())).first->second;
+}
+
+void Instrumentation::add_counter(std::string_view name, int64_t value) {
+    if (!is_enabled()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = counters_.find(name);
+    if (it == counters_.end()) {
+        counters_.emplace(std::string(name), value);
+    } else {
+        it->second += value;
+    }
+}
+
+void Instrumentation::record_span(std::string_view name, Clock::time_point start, Clock::time_point end) {
+    if (!is_enabled()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    spans_.push_back({std::string(name), thread_index(),
+                      duration_cast<microseconds>(start - origin_).count(),
+                      duration_cast<microseconds>(end - start).count()});
+}
+
+std::map<std::string, int64_t> Instrumentation::get_counters() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::map<std::string, int64_t>(counters_.begin(), counters_.end());
+}
+
+std::vector<Instrumentation::Span> Instrumentation::get_spans() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return spans_;
+}
+
+void Instrumentation::write_chrome_trace(std::ostream& out) const {
+    auto spans = get_spans();
+    auto counters = get_counters();
+
+    out << "{\"traceEvents\":[";
+    bool first = true;
+    for (const auto& span : spans) {
+        out << (first ? "" : ",") << "{\"name\":";
+        first = false;
+        write_json_string(out, span.name);
+        out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << span.thread
+            << ",\"ts\":" << span.start_us << ",\"dur\":" << span.duration_us << '}';
+    }
+
+    const int64_t now = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - origin_).count();
+    for (const auto& [name, value] : counters) {
+        out << (first ? "" : ",") << "{\"name\":";
+        first = false;
+        write_json_string(out, name);
+        out << ",\"ph\":\"C\",\"pid\":1,\"tid\":0,\"ts\":" << now << ",\"args\":{\"value\":" << value << "}}";
+    }
+    out << "]}\n";
+
+    if (!out) {
+        throw std::runtime_error("Failed to write trace output");
+    }
+}
+
+void Instrumentation::write_metrics(std::ostream& out) const {
+    struct Totals {
+        int64_t count = 0;
+        int64_t total_us = 0;
+    };
+
+    std::map<std::string, Totals> totals;
+    for (const auto& span : get_spans()) {
+        Totals& entry = totals[span.name];
+        entry.count++;
+        entry.total_us += span.duration_us;
+    }
+
+    for (const auto& [name, value] : get_counters()) {
+        out << "counter " << name << ' ' << value << '\n';
+    }
+    for (const auto& [name, entry] : totals) {
+        out << "span " << name << " count=" << entry.count << " total_us=" << entry.total_us << '\n';
+    }
+
+    if (!out) {
+        throw std::runtime_error("Failed to write metrics output");
+    }
+}
+
+void Instrumentation::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    counters_.clear();
+    spans_.clear();
+    origin_ = Clock::now();
+}
+
+ScopedSpan::ScopedSpan(std::string_view name)
+    : name_(name), active_(Instrumentation::instance().is_enabled()) {
+    if (active_) {
+        start_ = Instrumentation::Clock::now();
+    }
+}
+
+ScopedSpan::~ScopedSpan() {
+    if (active_) {
+        Instrumentation::instance().record_span(name_, start_, Instrumentation::Clock::now());
+    }
+}
+
+std::pmr::memory_resource* arena_upstream_resource() {
+#if PROCMINE_INSTRUMENTATION
+    static CountingResource resource;
+    return &resource;
+#else
+    return std::pmr::get_default_resource();
+#endif
+}
+
+}
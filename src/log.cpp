@@ -1,20 +1,440 @@
 #include "procmine/log.h"
 #include "procmine/database.h"
+#include "procmine/concurrency.h"
+#include "procmine/instrumentation.h"
+#include "procmine/sampling.h"
+#include <filesystem>
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
 #include <chrono>
 #include <iomanip>
 #include <unordered_set>
+#include <algorithm>
+#include <ctime>
+#include <string_view>
+#include <optional>
+#include <variant>
+#include <iterator>
+#include <future>
+#include <charconv>
+#include <thread>
+#include <atomic>
 
 namespace procmine {
 
+namespace {
+
+class TimestampFormatter {
+public:
+    std::string_view format(const std::chrono::system_clock::time_point& timestamp) {
+        std::time_t time = std::chrono::system_clock::to_time_t(timestamp);
+        if (!valid_ || time != cached_time_) {
+            std::tm tm = {};
+            localtime_r(&time, &tm);
+
+            char* out = std::to_chars(buffer_, buffer_ + 12, tm.tm_year + 1900).ptr;
+            out = put_field(out, '-', tm.tm_mon + 1);
+            out = put_field(out, '-', tm.tm_mday);
+            out = put_field(out, ' ', tm.tm_hour);
+            out = put_field(out, ':', tm.tm_min);
+            out = put_field(out, ':', tm.tm_sec);
+
+            length_ = out - buffer_;
+            cached_time_ = time;
+            valid_ = true;
+        }
+        return std::string_view(buffer_, length_);
+    }
+
+private:
+    static char* put_field(char* out, char separator, int value) {
+        *out++ = separator;
+        *out++ = static_cast<char>('0' + value / 10);
+        *out++ = static_cast<char>('0' + value % 10);
+        return out;
+    }
+
+    std::time_t cached_time_ = 0;
+    bool valid_ = false;
+    char buffer_[32];
+    size_t length_ = 0;
+};
+
+using SQLParam = std::variant<int64_t, std::string>;
+
+void bind_params(Database::Statement& stmt, const std::vector<SQLParam>& params, int offset = 0) {
+    for (size_t i = 0; i < params.size(); ++i) {
+        int index = offset + static_cast<int>(i) + 1;
+        if (std::holds_alternative<int64_t>(params[i])) {
+            stmt.bind(index, std::get<int64_t>(params[i]));
+        } else {
+            stmt.bind(index, std::get<std::string>(params[i]));
+        }
+    }
+}
+
+std::string placeholder_list(size_t count) {
+    std::string list = "(";
+    for (size_t i = 0; i < count; ++i) {
+        if (i > 0) list += ", ";
+        list += "?";
+    }
+    list += ")";
+    return list;
+}
+
+int64_t to_unix_seconds(const std::chrono::system_clock::time_point& timestamp) {
+    return std::chrono::duration_cast<std::chrono::seconds>(timestamp.time_since_epoch()).count();
+}
+
+std::string dimension_table(const std::string& table_name, const char* suffix) {
+    return Database::quote_identifier(table_name + "_" + suffix);
+}
+
+std::vector<std::string> load_dimension(Database& db, const std::string& table_name, const char* suffix) {
+    std::vector<std::string> names;
+    auto stmt = db.prepare("SELECT id, name FROM " + dimension_table(table_name, suffix));
+    while (stmt->step()) {
+        int64_t id = stmt->column_int64(0);
+        if (id < 0) {
+            throw std::runtime_error("Invalid dimension id in " + table_name + "_" + suffix);
+        }
+        if (static_cast<size_t>(id) >= names.size()) {
+            names.resize(id + 1);
+        }
+        names[id] = stmt->column_text(1);
+    }
+    return names;
+}
+
+const std::string& dimension_value(const std::vector<std::string>& names, int64_t id) {
+    if (id < 0 || static_cast<size_t>(id) >= names.size()) {
+        throw std::runtime_error("Dangling dimension reference in event table");
+    }
+    return names[id];
+}
+
+bool parse_timestamp(const std::string& text, std::chrono::system_clock::time_point& timestamp) {
+    std::tm tm = {};
+    std::istringstream ts_stream(text);
+    ts_stream >> std::get_time(&tm, "%Y-%m-%dT%H:%M:%S");
+    
+    if (ts_stream.fail()) {
+        ts_stream.clear();
+        ts_stream.str(text);
+        ts_stream >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
+    }
+    
+    if (ts_stream.fail()) {
+        return false;
+    }
+
+    timestamp = std::chrono::system_clock::from_time_t(std::mktime(&tm));
+    return true;
+}
+
+std::string timestamp_expression(const std::string& timestamp_column) {
+    return "julianday(" + Database::quote_identifier(timestamp_column) + ")";
+}
+
+void compile_flat_filter(const LogFilter& filter, const std::string& case_column,
+                         const std::string& activity_column, const std::string& timestamp_column,
+                         std::vector<std::string>& conditions, std::vector<SQLParam>& params) {
+    TimestampFormatter formatter;
+    const std::string timestamp = timestamp_expression(timestamp_column);
+
+    if (filter.start) {
+        conditions.push_back(timestamp + " >= julianday(?)");
+        params.emplace_back(std::string(formatter.format(*filter.start)));
+    }
+    if (filter.end) {
+        conditions.push_back(timestamp + " <= julianday(?)");
+        params.emplace_back(std::string(formatter.format(*filter.end)));
+    }
+    if (!filter.activities.empty()) {
+        conditions.push_back(Database::quote_identifier(activity_column) + " IN "
+                             + placeholder_list(filter.activities.size()));
+        params.insert(params.end(), filter.activities.begin(), filter.activities.end());
+    }
+    if (!filter.case_ids.empty()) {
+        conditions.push_back(Database::quote_identifier(case_column) + " IN "
+                             + placeholder_list(filter.case_ids.size()));
+        params.insert(params.end(), filter.case_ids.begin(), filter.case_ids.end());
+    }
+    for (const auto& attr : filter.attributes) {
+        conditions.push_back(Database::quote_identifier(attr.first) + " = ?");
+        params.emplace_back(attr.second);
+    }
+}
+
+void compile_normalized_filter(const LogFilter& filter, const std::string& table_name,
+                               std::vector<std::string>& conditions, std::vector<SQLParam>& params) {
+    if (filter.start) {
+        conditions.push_back("e.timestamp >= ?");
+        params.emplace_back(to_unix_seconds(*filter.start));
+    }
+    if (filter.end) {
+        conditions.push_back("e.timestamp <= ?");
+        params.emplace_back(to_unix_seconds(*filter.end));
+    }
+    if (!filter.activities.empty()) {
+        conditions.push_back("e.activity_ref IN (SELECT id FROM " + dimension_table(table_name, "activities")
+                             + " WHERE name IN " + placeholder_list(filter.activities.size()) + ")");
+        params.insert(params.end(), filter.activities.begin(), filter.activities.end());
+    }
+    if (!filter.case_ids.empty()) {
+        conditions.push_back("e.case_ref IN (SELECT id FROM " + dimension_table(table_name, "cases")
+                             + " WHERE name IN " + placeholder_list(filter.case_ids.size()) + ")");
+        params.insert(params.end(), filter.case_ids.begin(), filter.case_ids.end());
+    }
+    for (const auto& attr : filter.attributes) {
+        conditions.push_back("EXISTS (SELECT 1 FROM " + dimension_table(table_name, "attributes")
+                             + " a WHERE a.event_ref = e.id AND a.name_ref = (SELECT id FROM "
+                             + dimension_table(table_name, "attribute_names")
+                             + " WHERE name = ?) AND a.value = ?)");
+        params.emplace_back(attr.first);
+        params.emplace_back(attr.second);
+    }
+}
+
+class NormalizedDimension {
+public:
+    NormalizedDimension(Database& db, const std::string& table) : next_id_(1) {
+        auto existing = db.prepare("SELECT id, name FROM " + table);
+        while (existing->step()) {
+            int64_t id = existing->column_int64(0);
+            ids_.emplace(std::string(existing->column_text(1)), id);
+            next_id_ = std::max(next_id_, id + 1);
+        }
+        insert_ = db.prepare("INSERT INTO " + table + " (id, name) VALUES (?, ?)");
+    }
+
+    int64_t id_for(const std::string& name) {
+        auto it = ids_.find(name);
+        if (it != ids_.end()) {
+            return it->second;
+        }
+
+        int64_t id = next_id_++;
+        insert_->bind(1, id);
+        insert_->bind_static(2, name);
+        if (!insert_->execute()) {
+            throw std::runtime_error("Failed to insert dimension value: " + name);
+        }
+        ids_.emplace(name, id);
+        return id;
+    }
+
+private:
+    std::unordered_map<std::string, int64_t> ids_;
+    std::shared_ptr<Database::Statement> insert_;
+    int64_t next_id_;
+};
+
+class BulkLoadPragmas {
+public:
+    explicit BulkLoadPragmas(Database& db) : db_(db) {
+        journal_mode_ = db_.query("PRAGMA journal_mode")->get_string(0, 0);
+        synchronous_ = db_.query("PRAGMA synchronous")->get_string(0, 0);
+        cache_size_ = db_.query("PRAGMA cache_size")->get_string(0, 0);
+
+        db_.execute("PRAGMA journal_mode = MEMORY");
+        db_.execute("PRAGMA synchronous = OFF");
+        db_.execute("PRAGMA cache_size = -262144");
+    }
+
+    ~BulkLoadPragmas() {
+        db_.execute("PRAGMA cache_size = " + cache_size_);
+        db_.execute("PRAGMA synchronous = " + synchronous_);
+        db_.execute("PRAGMA journal_mode = " + journal_mode_);
+    }
+
+private:
+    Database& db_;
+    std::string journal_mode_;
+    std::string synchronous_;
+    std::string cache_size_;
+};
+
+std::vector<std::string> collect_attribute_names(const EventLog& log) {
+    std::unordered_set<std::string> attribute_names;
+    for (const auto& trace : log.get_traces()) {
+        for (const auto& event : trace.get_events()) {
+            for (const auto& attr : event.attributes) {
+                attribute_names.insert(attr.first);
+            }
+        }
+    }
+    if (const auto& schema = log.get_attribute_schema()) {
+        for (size_t i = 0; i < schema->column_count(); ++i) {
+            attribute_names.insert(schema->get_column(i).get_name());
+        }
+    }
+    return std::vector<std::string>(attribute_names.begin(), attribute_names.end());
+}
+
+class AttributeLookup {
+public:
+    AttributeLookup(const EventLog& log, const std::vector<std::string>& attribute_names)
+        : attribute_names_(attribute_names), columns_(attribute_names.size(), nullptr) {
+        if (const auto& schema = log.get_attribute_schema()) {
+            for (size_t i = 0; i < attribute_names_.size(); ++i) {
+                columns_[i] = schema->find_column(attribute_names_[i]);
+            }
+        }
+    }
+
+    const std::string* find(const Event& event, size_t index, std::string& scratch) const {
+        if (!event.attributes.empty()) {
+            auto it = event.attributes.find(attribute_names_[index]);
+            if (it != event.attributes.end()) {
+                return &it->second;
+            }
+        }
+        const AttributeColumn* column = columns_[index];
+        if (column != nullptr && event.attribute_row != Event::no_attribute_row &&
+            column->format(event.attribute_row, scratch)) {
+            return &scratch;
+        }
+        return nullptr;
+    }
+
+    const AttributeColumn* get_column(size_t index) const {
+        return columns_[index];
+    }
+
+private:
+    std::vector<std::string> attribute_names_;
+    std::vector<const AttributeColumn*> columns_;
+};
+
+class CSVRowFormatter {
+public:
+    CSVRowFormatter(char delimiter, const std::vector<std::string>& attribute_names,
+                    const AttributeLookup& lookup)
+        : delimiter_(delimiter), attribute_names_(attribute_names), lookup_(lookup),
+          slots_(attribute_names.size(), nullptr), scratch_(attribute_names.size()) {
+        for (size_t i = 0; i < attribute_names_.size(); ++i) {
+            columns_.emplace(attribute_names_[i], i);
+        }
+    }
+
+    void append_header(std::string& out) const {
+        out += "case_id";
+        out += delimiter_;
+        out += "activity";
+        out += delimiter_;
+        out += "timestamp";
+        out += delimiter_;
+        out += "resource";
+        for (const auto& attr_name : attribute_names_) {
+            out += delimiter_;
+            out += attr_name;
+        }
+        out += '\n';
+    }
+
+    void append_row(std::string& out, const std::string& case_id, const Event& event) {
+        out += case_id;
+        out += delimiter_;
+        out += event.activity;
+        out += delimiter_;
+        out += timestamps_.format(event.timestamp);
+        out += delimiter_;
+        out += event.resource;
+
+        if (!slots_.empty()) {
+            std::fill(slots_.begin(), slots_.end(), nullptr);
+            for (const auto& attr : event.attributes) {
+                auto it = columns_.find(attr.first);
+                if (it != columns_.end()) {
+                    slots_[it->second] = &attr.second;
+                }
+            }
+            if (event.attribute_row != Event::no_attribute_row) {
+                for (size_t i = 0; i < slots_.size(); ++i) {
+                    const AttributeColumn* column = lookup_.get_column(i);
+                    if (slots_[i] == nullptr && column != nullptr &&
+                        column->format(event.attribute_row, scratch_[i])) {
+                        slots_[i] = &scratch_[i];
+                    }
+                }
+            }
+            for (const std::string* value : slots_) {
+                out += delimiter_;
+                if (value != nullptr) {
+                    out += *value;
+                }
+            }
+        }
+
+        out += '\n';
+    }
+
+private:
+    char delimiter_;
+    std::vector<std::string> attribute_names_;
+    AttributeLookup lookup_;
+    std::unordered_map<std::string, size_t> columns_;
+    std::vector<const std::string*> slots_;
+    std::vector<std::string> scratch_;
+    TimestampFormatter timestamps_;
+};
+
+void create_flat_table(Database& db, const std::string& table_name,
+                       const std::vector<std::string>& attribute_names) {
+    std::string create_table = "CREATE TABLE IF NOT EXISTS " + Database::quote_identifier(table_name) + " ("
+                              + "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+                              + "case_id TEXT, "
+                              + "activity TEXT, "
+                              + "timestamp TEXT, "
+                              + "resource TEXT";
+    
+    for (const auto& attr_name : attribute_names) {
+        create_table += ", " + Database::quote_identifier(attr_name) + " TEXT";
+    }
+    
+    create_table += ")";
+    
+    if (!db.execute(create_table)) {
+        throw std::runtime_error("Failed to create table: " + db.get_error_message());
+    }
+}
+
+std::string build_flat_insert(const std::string& table_name,
+                              const std::vector<std::string>& attribute_names, size_t rows) {
+    std::string sql = "INSERT INTO " + Database::quote_identifier(table_name)
+                    + " (case_id, activity, timestamp, resource";
+    for (const auto& attr_name : attribute_names) {
+        sql += ", " + Database::quote_identifier(attr_name);
+    }
+    sql += ") VALUES ";
+
+    std::string row_placeholders = placeholder_list(4 + attribute_names.size());
+    sql.reserve(sql.size() + rows * (row_placeholders.size() + 2));
+    for (size_t i = 0; i < rows; ++i) {
+        if (i > 0) sql += ", ";
+        sql += row_placeholders;
+    }
+    return sql;
+}
+
+}
+
+bool LogFilter::empty() const {
+    return !start && !end && activities.empty() && case_ids.empty() && attributes.empty();
+}
+
 CSVLogReader::CSVLogReader(const std::string& filepath, char delimiter)
-    : filepath_(filepath), delimiter_(delimiter),
-      case_column_("case_id"), activity_column_("activity"),
+    : filepath_(filepath), delimiter_(delimiter), columnar_attributes_(false),
+      case_fraction_(1.0), case_seed_(0), skipped_rows_(0), case_column_("case_id"), activity_column_("activity"),
       timestamp_column_("timestamp"), resource_column_("resource") {}
 
 std::shared_ptr<EventLog> CSVLogReader::read() {
+    PROCMINE_TRACE_SCOPE("csv.read");
+    skipped_rows_ = 0;
+
     std::ifstream file(filepath_);
     if (!file.is_open()) {
         throw std::runtime_error("Cannot open file: " + filepath_);
@@ -22,6 +442,8 @@ std::shared_ptr<EventLog> CSVLogReader::read() {
     
     std::string line;
     std::shared_ptr<EventLog> log = std::make_shared<EventLog>();
+    log->use_arena();
+    const Trace::allocator_type allocator = log->get_allocator();
 
     std::getline(file, line);
     std::stringstream ss(line);
@@ -44,27 +466,66 @@ std::shared_ptr<EventLog> CSVLogReader::read() {
         throw std::runtime_error("Required columns not found in CSV header");
     }
 
+    std::vector<char> attribute_column(header.size(), 1);
+    for (int idx : {case_idx, activity_idx, timestamp_idx, resource_idx}) {
+        if (idx != -1) {
+            attribute_column[static_cast<size_t>(idx)] = 0;
+        }
+    }
+
+    std::shared_ptr<AttributeSchema> schema;
+    std::vector<std::pair<size_t, size_t>> schema_columns;
+    if (columnar_attributes_) {
+        schema = std::make_shared<AttributeSchema>();
+        for (size_t i = 0; i < header.size(); ++i) {
+            if (attribute_column[i]) {
+                auto type = attribute_types_.find(header[i]);
+                schema_columns.emplace_back(i, schema->add_column(
+                    header[i], type == attribute_types_.end() ? AttributeType::String : type->second));
+            }
+        }
+        log->set_attribute_schema(schema);
+    }
+
     std::unordered_map<std::string, Trace> traces;
 
     std::vector<std::string> case_order;
+    uint64_t rows_read = 0;
+    uint64_t events_read = 0;
+    uint64_t bytes_read = line.size() + 1;
+    int64_t tokenize_ns = 0;
+    int64_t timestamp_ns = 0;
+    int64_t grouping_ns = 0;
 
     while (std::getline(file, line)) {
-        ss.clear();
-        ss.str(line);
+        rows_read++;
+        bytes_read += line.size() + 1;
         std::vector<std::string> row;
-        
-        while (std::getline(ss, cell, delimiter_)) {
-            row.push_back(cell);
+
+        {
+            PROCMINE_TIME_SCOPE(tokenize_ns);
+            ss.clear();
+            ss.str(line);
+            while (std::getline(ss, cell, delimiter_)) {
+                row.push_back(cell);
+            }
+            if (!line.empty() && line.back() == delimiter_) {
+                row.emplace_back();
+            }
         }
         
         if (row.size() != header.size()) {
+            skipped_rows_++;
             continue;
         }
         
         std::string case_id = row[case_idx];
+        if (!sample_case(case_id, case_fraction_, case_seed_)) {
+            continue;
+        }
         std::string activity = row[activity_idx];
 
-        Event event;
+        Event event(allocator);
         event.activity = activity;
         
         if (resource_idx != -1) {
@@ -72,6 +533,7 @@ std::shared_ptr<EventLog> CSVLogReader::read() {
         }
         
         if (timestamp_idx != -1) {
+            PROCMINE_TIME_SCOPE(timestamp_ns);
             try {
                 std::tm tm = {};
                 std::istringstream ts_stream(row[timestamp_idx]);
@@ -93,27 +555,51 @@ std::shared_ptr<EventLog> CSVLogReader::read() {
             event.timestamp = std::chrono::system_clock::now();
         }
 
-        for (size_t i = 0; i < header.size(); ++i) {
-            if (i != case_idx && i != activity_idx && i != timestamp_idx && i != resource_idx) {
-                event.attributes[header[i]] = row[i];
+        if (schema) {
+            event.attribute_row = schema->add_row();
+            for (const auto& column : schema_columns) {
+                schema->set(event.attribute_row, column.second, row[column.first]);
+            }
+        } else {
+            for (size_t i = 0; i < header.size(); ++i) {
+                if (attribute_column[i]) {
+                    event.attributes[header[i]] = row[i];
+                }
             }
         }
 
-        if (traces.find(case_id) == traces.end()) {
+        PROCMINE_TIME_SCOPE(grouping_ns);
+        auto slot = traces.try_emplace(case_id, case_id, allocator);
+        if (slot.second) {
             case_order.push_back(case_id);
-            traces[case_id] = Trace(case_id);
         }
         
-        traces[case_id].add_event(event);
+        slot.first->second.add_event(std::move(event));
+        events_read++;
     }
 
-    for (const auto& case_id : case_order) {
-        log->add_trace(std::move(traces[case_id]));
+    {
+        PROCMINE_TIME_SCOPE(grouping_ns);
+        for (const auto& case_id : case_order) {
+            log->add_trace(std::move(traces[case_id]));
+        }
     }
+
+    PROCMINE_COUNTER_ADD("csv.rows_read", rows_read);
+    PROCMINE_COUNTER_ADD("csv.rows_skipped", skipped_rows_);
+    PROCMINE_COUNTER_ADD("csv.bytes_read", bytes_read);
+    PROCMINE_COUNTER_ADD("csv.events_read", events_read);
+    PROCMINE_COUNTER_ADD("csv.tokenize_us", tokenize_ns / 1000);
+    PROCMINE_COUNTER_ADD("csv.timestamp_parse_us", timestamp_ns / 1000);
+    PROCMINE_COUNTER_ADD("csv.case_grouping_us", grouping_ns / 1000);
     
     return log;
 }
 
+size_t CSVLogReader::get_skipped_rows() const {
+    return skipped_rows_;
+}
+
 void CSVLogReader::set_case_column(const std::string& column_name) {
     case_column_ = column_name;
 }
@@ -130,89 +616,158 @@ void CSVLogReader::set_resource_column(const std::string& column_name) {
     resource_column_ = column_name;
 }
 
+void CSVLogReader::set_columnar_attributes(bool enabled) {
+    columnar_attributes_ = enabled;
+}
+
+void CSVLogReader::set_attribute_type(const std::string& column_name, AttributeType type) {
+    attribute_types_[column_name] = type;
+}
+
+void CSVLogReader::set_case_sampling(double fraction, uint64_t seed) {
+    if (!(fraction > 0.0 && fraction <= 1.0)) {
+        throw std::runtime_error("Sampling fraction must be in (0, 1]");
+    }
+    case_fraction_ = fraction;
+    case_seed_ = seed;
+}
+
+struct SQLiteLogReader::NormalizedDimensions {
+    std::vector<std::string> cases;
+    std::vector<std::string> activities;
+    std::vector<std::string> resources;
+    std::vector<std::string> attribute_names;
+};
+
 SQLiteLogReader::SQLiteLogReader(const std::string& db_path, const std::string& query)
-    : db_path_(db_path), query_(query),
+    : db_path_(db_path), query_(query), layout_(SQLiteLayout::Flat), parallelism_(1),
+      columnar_attributes_(false), case_fraction_(1.0), case_seed_(0),
       case_column_("case_id"), activity_column_("activity"),
       timestamp_column_("timestamp"), resource_column_("resource") {}
 
 std::shared_ptr<EventLog> SQLiteLogReader::read() {
-    Database db(db_path_);
-    auto query_result = db.query(query_);
-    
-    std::shared_ptr<EventLog> log = std::make_shared<EventLog>();
+    PROCMINE_TRACE_SCOPE("sqlite.read");
+    auto log = parallelism_ != 1 && !table_name_.empty() ? read_parallel() : read_serial();
+    if (columnar_attributes_) {
+        PROCMINE_TRACE_SCOPE("sqlite.columnarize");
+        log->columnarize_attributes(attribute_types_);
+    }
+    PROCMINE_COUNTER_ADD("sqlite.traces_read", log->get_traces().size());
+    PROCMINE_COUNTER_ADD("sqlite.events_read", log->event_count());
+    return log;
+}
 
-    auto column_names = query_result->get_column_names();
-    
-    bool has_case_column = false;
-    bool has_activity_column = false;
+std::shared_ptr<EventLog> SQLiteLogReader::read_serial() {
+
+    Database db(db_path_, true);
+    auto log = std::make_shared<EventLog>();
+    log->use_arena();
+
+    if (!table_name_.empty() && layout_ == SQLiteLayout::Normalized) {
+        NormalizedDimensions dimensions = load_dimensions(db);
+        for (auto& entry : read_normalized(db, dimensions, "", {}, log->get_allocator())) {
+            log->add_trace(std::move(entry.second));
+        }
+        return log;
+    }
+
+    for (auto& trace : read_flat(db, "", {}, log->get_allocator())) {
+        log->add_trace(std::move(trace));
+    }
     
-    for (const auto& col : column_names) {
-        if (col == case_column_) has_case_column = true;
-        else if (col == activity_column_) has_activity_column = true;
+    return log;
+}
+
+std::vector<Trace> SQLiteLogReader::read_flat(Database& db, const std::string& partition_condition,
+                                              const std::vector<int64_t>& partition_params,
+                                              const Trace::allocator_type& allocator) const {
+    std::vector<std::string> conditions;
+    std::vector<SQLParam> params;
+    compile_flat_filter(filter_, case_column_, activity_column_, timestamp_column_, conditions, params);
+
+    if (!partition_condition.empty()) {
+        conditions.push_back(partition_condition);
+        params.insert(params.end(), partition_params.begin(), partition_params.end());
+    }
+
+    std::string sql = query_;
+    if (!table_name_.empty()) {
+        sql = "SELECT * FROM " + Database::quote_identifier(table_name_);
+    } else if (!conditions.empty()) {
+        sql = "SELECT * FROM (" + query_ + ")";
+    }
+    for (size_t i = 0; i < conditions.size(); ++i) {
+        sql += (i == 0 ? " WHERE " : " AND ") + conditions[i];
     }
+    if (!partition_condition.empty()) {
+        sql += " ORDER BY rowid";
+    }
+
+    std::shared_ptr<QueryResult> query_result;
+    if (params.empty()) {
+        query_result = db.query(sql);
+    } else {
+        auto stmt = db.prepare(sql);
+        bind_params(*stmt, params);
+        query_result = stmt->query();
+    }
+
+    auto column_names = query_result->get_column_names();
+    auto column_index = [&](const std::string& name) {
+        auto it = std::find(column_names.begin(), column_names.end(), name);
+        return it == column_names.end() ? -1 : static_cast<int>(it - column_names.begin());
+    };
+
+    int case_idx = column_index(case_column_);
+    int activity_idx = column_index(activity_column_);
+    int timestamp_idx = column_index(timestamp_column_);
+    int resource_idx = column_index(resource_column_);
     
-    if (!has_case_column || !has_activity_column) {
+    if (case_idx == -1 || activity_idx == -1) {
         throw std::runtime_error("Required columns not found in query result");
     }
 
-    std::unordered_map<std::string, Trace> traces;
+    std::vector<int> attribute_columns;
+    for (int col = 0; col < static_cast<int>(column_names.size()); ++col) {
+        if (col != case_idx && col != activity_idx && col != timestamp_idx && col != resource_idx) {
+            attribute_columns.push_back(col);
+        }
+    }
+
+    std::vector<Trace> traces;
+    std::unordered_map<std::string, size_t> case_slots;
 
     for (int row = 0; row < query_result->get_row_count(); ++row) {
-        std::string case_id = query_result->get_string(row, case_column_);
-        std::string activity = query_result->get_string(row, activity_column_);
+        std::string case_id = query_result->get_string(row, case_idx);
+        if (!sample_case(case_id, case_fraction_, case_seed_)) {
+            continue;
+        }
 
-        Event event;
-        event.activity = activity;
+        Event event(allocator);
+        event.activity = query_result->get_string(row, activity_idx);
 
-        if (std::find(column_names.begin(), column_names.end(), resource_column_) != column_names.end()) {
-            event.resource = query_result->get_string(row, resource_column_);
+        if (resource_idx != -1) {
+            event.resource = query_result->get_string(row, resource_idx);
         }
 
-        if (std::find(column_names.begin(), column_names.end(), timestamp_column_) != column_names.end()) {
-            try {
-                std::string timestamp_str = query_result->get_string(row, timestamp_column_);
-
-                std::tm tm = {};
-                std::istringstream ts_stream(timestamp_str);
-                ts_stream >> std::get_time(&tm, "%Y-%m-%dT%H:%M:%S");
-                
-                if (ts_stream.fail()) {
-                    ts_stream.clear();
-                    ts_stream.str(timestamp_str);
-                    ts_stream >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
-                }
-                
-                if (!ts_stream.fail()) {
-                    event.timestamp = std::chrono::system_clock::from_time_t(std::mktime(&tm));
-                } else {
-                    event.timestamp = std::chrono::system_clock::now();
-                }
-            } catch (...) {
-                event.timestamp = std::chrono::system_clock::now();
-            }
-        } else {
+        if (timestamp_idx == -1 ||
+            !parse_timestamp(query_result->get_string(row, timestamp_idx), event.timestamp)) {
             event.timestamp = std::chrono::system_clock::now();
         }
 
-        for (const auto& col : column_names) {
-            if (col != case_column_ && col != activity_column_ && 
-                col != timestamp_column_ && col != resource_column_) {
-                event.attributes[col] = query_result->get_string(row, col);
-            }
+        for (int col : attribute_columns) {
+            event.attributes[column_names[col]] = query_result->get_string(row, col);
         }
 
-        if (traces.find(case_id) == traces.end()) {
-            traces[case_id] = Trace(case_id);
+        auto slot = case_slots.try_emplace(case_id, traces.size());
+        if (slot.second) {
+            traces.emplace_back(case_id, allocator);
         }
         
-        traces[case_id].add_event(event);
-    }
-
-    for (auto& trace_pair : traces) {
-        log->add_trace(trace_pair.second);
+        traces[slot.first->second].add_event(std::move(event));
     }
     
-    return log;
+    return traces;
 }
 
 void SQLiteLogReader::set_case_column(const std::string& column_name) {
@@ -231,104 +786,507 @@ void SQLiteLogReader::set_resource_column(const std::string& column_name) {
     resource_column_ = column_name;
 }
 
-CSVLogWriter::CSVLogWriter(const std::string& filepath, char delimiter)
-    : filepath_(filepath), delimiter_(delimiter) {}
+void SQLiteLogReader::set_table(const std::string& table_name, SQLiteLayout layout) {
+    table_name_ = table_name;
+    layout_ = layout;
+}
 
-void CSVLogWriter::write(const EventLog& log) {
-    std::ofstream file(filepath_);
-    if (!file.is_open()) {
-        throw std::runtime_error("Cannot open file for writing: " + filepath_);
-    }
+void SQLiteLogReader::set_filter(const LogFilter& filter) {
+    filter_ = filter;
+}
 
-    file << "case_id" << delimiter_ << "activity" << delimiter_ 
-         << "timestamp" << delimiter_ << "resource";
+void SQLiteLogReader::set_parallelism(unsigned threads) {
+    parallelism_ = threads;
+}
 
-    std::unordered_set<std::string> attribute_names;
-    for (const auto& trace : log.get_traces()) {
-        for (const auto& event : trace.get_events()) {
-            for (const auto& attr : event.attributes) {
-                attribute_names.insert(attr.first);
-            }
-        }
+void SQLiteLogReader::set_columnar_attributes(bool enabled) {
+    columnar_attributes_ = enabled;
+}
+
+void SQLiteLogReader::set_attribute_type(const std::string& column_name, AttributeType type) {
+    attribute_types_[column_name] = type;
+}
+
+void SQLiteLogReader::set_case_sampling(double fraction, uint64_t seed) {
+    if (!(fraction > 0.0 && fraction <= 1.0)) {
+        throw std::runtime_error("Sampling fraction must be in (0, 1]");
     }
+    case_fraction_ = fraction;
+    case_seed_ = seed;
+}
 
-    for (const auto& attr_name : attribute_names) {
-        file << delimiter_ << attr_name;
+void SQLiteLogReader::create_filter_indexes() {
+    if (table_name_.empty()) {
+        throw std::runtime_error("Filter indexes require a table set with set_table");
     }
-    file << std::endl;
 
-    for (const auto& trace : log.get_traces()) {
-        for (const auto& event : trace.get_events()) {
-            file << trace.get_case_id() << delimiter_
-                 << event.activity << delimiter_;
+    Database db(db_path_);
 
-            auto time_t = std::chrono::system_clock::to_time_t(event.timestamp);
-            std::tm tm = *std::localtime(&time_t);
-            file << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << delimiter_
-                 << event.resource;
-
-            for (const auto& attr_name : attribute_names) {
-                file << delimiter_;
-                auto it = event.attributes.find(attr_name);
-                if (it != event.attributes.end()) {
-                    file << it->second;
-                }
-            }
-            
-            file << std::endl;
+    auto create_index = [&](const std::string& table, const std::string& name,
+                            const std::string& columns) {
+        std::string sql = "CREATE INDEX IF NOT EXISTS " + Database::quote_identifier(name)
+                        + " ON " + table + " (" + columns + ")";
+        if (!db.execute(sql)) {
+            throw std::runtime_error("Failed to create index: " + db.get_error_message());
+        }
+    };
+
+    const std::string table = Database::quote_identifier(table_name_);
+
+    if (layout_ == SQLiteLayout::Normalized) {
+        if (filter_.start || filter_.end) {
+            create_index(table, "idx_" + table_name_ + "_timestamp", "timestamp");
         }
+        if (!filter_.activities.empty()) {
+            create_index(table, "idx_" + table_name_ + "_activity_ref", "activity_ref");
+        }
+        if (!filter_.case_ids.empty()) {
+            create_index(table, "idx_" + table_name_ + "_case_ref", "case_ref");
+        }
+        if (!filter_.attributes.empty()) {
+            create_index(dimension_table(table_name_, "attributes"),
+                         "idx_" + table_name_ + "_attributes_name_value", "name_ref, value");
+        }
+        return;
+    }
+
+    auto create_column_index = [&](const std::string& column) {
+        create_index(table, "idx_" + table_name_ + "_" + column, Database::quote_identifier(column));
+    };
+
+    if (filter_.start || filter_.end) {
+        create_index(table, "idx_" + table_name_ + "_" + timestamp_column_ + "_julianday",
+                     timestamp_expression(timestamp_column_));
+    }
+    if (!filter_.activities.empty()) {
+        create_column_index(activity_column_);
+    }
+    if (!filter_.case_ids.empty()) {
+        create_column_index(case_column_);
+    }
+    for (const auto& attr : filter_.attributes) {
+        create_column_index(attr.first);
     }
 }
 
-SQLiteLogWriter::SQLiteLogWriter(const std::string& db_path, const std::string& table_name)
-    : db_path_(db_path), table_name_(table_name) {}
+SQLiteLogReader::NormalizedDimensions SQLiteLogReader::load_dimensions(Database& db) const {
+    NormalizedDimensions dimensions;
+    dimensions.cases = load_dimension(db, table_name_, "cases");
+    dimensions.activities = load_dimension(db, table_name_, "activities");
+    dimensions.resources = load_dimension(db, table_name_, "resources");
+    dimensions.attribute_names = load_dimension(db, table_name_, "attribute_names");
+    return dimensions;
+}
 
-void SQLiteLogWriter::write(const EventLog& log) {
-    Database db(db_path_);
+std::vector<std::pair<int64_t, Trace>> SQLiteLogReader::read_normalized(
+    Database& db, const NormalizedDimensions& dimensions,
+    const std::string& partition_condition,
+    const std::vector<int64_t>& partition_params,
+    const Trace::allocator_type& allocator) const {
 
-    std::unordered_set<std::string> attribute_names;
-    for (const auto& trace : log.get_traces()) {
-        for (const auto& event : trace.get_events()) {
-            for (const auto& attr : event.attributes) {
-                attribute_names.insert(attr.first);
+    std::vector<std::string> conditions;
+    std::vector<SQLParam> params;
+    compile_normalized_filter(filter_, table_name_, conditions, params);
+
+    if (!partition_condition.empty()) {
+        conditions.push_back(partition_condition);
+        params.insert(params.end(), partition_params.begin(), partition_params.end());
+    }
+
+    std::string where;
+    for (size_t i = 0; i < conditions.size(); ++i) {
+        where += (i == 0 ? " WHERE " : " AND ") + conditions[i];
+    }
+
+    const std::string events_source = Database::quote_identifier(table_name_) + " e" + where;
+
+    auto events = db.prepare("SELECT e.id, e.case_ref, e.activity_ref, e.resource_ref, e.timestamp FROM "
+                             + events_source + " ORDER BY e.id");
+    bind_params(*events, params);
+
+    std::string attribute_sql = "SELECT event_ref, name_ref, value FROM "
+                              + dimension_table(table_name_, "attributes");
+    if (!where.empty()) {
+        attribute_sql += " WHERE event_ref IN (SELECT e.id FROM " + events_source + ")";
+    }
+    auto attributes = db.prepare(attribute_sql + " ORDER BY event_ref");
+    bind_params(*attributes, params);
+
+    std::vector<std::pair<int64_t, Trace>> traces;
+    std::vector<int64_t> case_slots(dimensions.cases.size(), -1);
+
+    bool has_attribute = attributes->step();
+
+    while (events->step()) {
+        int64_t event_id = events->column_int64(0);
+        int64_t case_ref = events->column_int64(1);
+        const std::string& case_id = dimension_value(dimensions.cases, case_ref);
+        if (!sample_case(case_id, case_fraction_, case_seed_)) {
+            continue;
+        }
+
+        Event event(allocator);
+        event.activity = dimension_value(dimensions.activities, events->column_int64(2));
+
+        if (!events->column_is_null(3)) {
+            event.resource = dimension_value(dimensions.resources, events->column_int64(3));
+        }
+
+        if (!events->column_is_null(4)) {
+            event.timestamp = std::chrono::system_clock::time_point(
+                std::chrono::seconds(events->column_int64(4)));
+        } else {
+            event.timestamp = std::chrono::system_clock::now();
+        }
+
+        while (has_attribute && attributes->column_int64(0) < event_id) {
+            has_attribute = attributes->step();
+        }
+        while (has_attribute && attributes->column_int64(0) == event_id) {
+            event.attributes[dimension_value(dimensions.attribute_names, attributes->column_int64(1))] =
+                attributes->column_text(2);
+            has_attribute = attributes->step();
+        }
+
+        if (case_slots[case_ref] == -1) {
+            case_slots[case_ref] = traces.size();
+            traces.emplace_back(event_id, Trace(case_id, allocator));
+        }
+
+        traces[case_slots[case_ref]].second.add_event(std::move(event));
+    }
+    
+    return traces;
+}
+
+std::shared_ptr<EventLog> SQLiteLogReader::read_parallel() {
+    const unsigned workers = resolve_thread_count(parallelism_);
+
+    Database db(db_path_, true);
+    auto journal = db.query("PRAGMA journal_mode");
+    if (journal->get_row_count() == 1 && journal->get_string(0, 0) == "wal") {
+        return read_serial();
+    }
+
+    // Workers read through separate connections. Holding a read transaction here keeps
+    // the shared lock, so no writer can commit between the partition reads.
+    if (!db.begin_transaction()) {
+        throw std::runtime_error("Failed to begin read transaction: " + db.get_error_message());
+    }
+
+    auto log = std::make_shared<EventLog>();
+    log->use_arena();
+
+    std::vector<Trace::allocator_type> allocators;
+    for (unsigned worker = 0; worker < workers; ++worker) {
+        allocators.emplace_back(log->create_arena());
+    }
+
+    if (layout_ == SQLiteLayout::Normalized) {
+        const NormalizedDimensions dimensions = load_dimensions(db);
+        std::vector<std::vector<std::pair<int64_t, Trace>>> partitions(workers);
+
+        const int64_t case_count = static_cast<int64_t>(dimensions.cases.size());
+        const int64_t case_span = case_count / workers + 1;
+
+        run_workers(workers, [&](unsigned worker) {
+            int64_t lower = case_span * worker;
+            if (lower >= case_count) {
+                return;
             }
+            int64_t upper = std::min(case_count - 1, lower + case_span - 1);
+
+            Database worker_db(db_path_, true);
+            partitions[worker] = read_normalized(worker_db, dimensions, "e.case_ref BETWEEN ? AND ?",
+                                                 {lower, upper}, allocators[worker]);
+        });
+
+        std::vector<std::pair<int64_t, Trace>> traces;
+        for (auto& partition : partitions) {
+            std::move(partition.begin(), partition.end(), std::back_inserter(traces));
         }
+        std::sort(traces.begin(), traces.end(), [](const auto& a, const auto& b) {
+            return a.first < b.first;
+        });
+        for (auto& entry : traces) {
+            log->add_trace(std::move(entry.second));
+        }
+        return log;
     }
 
-    std::string create_table = "CREATE TABLE IF NOT EXISTS " + table_name_ + " ("
-                              + "id INTEGER PRIMARY KEY AUTOINCREMENT, "
-                              + "case_id TEXT, "
-                              + "activity TEXT, "
-                              + "timestamp TEXT, "
-                              + "resource TEXT";
-    
-    for (const auto& attr_name : attribute_names) {
-        create_table += ", " + attr_name + " TEXT";
+    auto bounds = db.prepare("SELECT MIN(rowid), MAX(rowid) FROM " + Database::quote_identifier(table_name_));
+    if (!bounds->step() || bounds->column_is_null(0)) {
+        return log;
+    }
+    const int64_t min_rowid = bounds->column_int64(0);
+    const int64_t max_rowid = bounds->column_int64(1);
+    bounds.reset();
+
+    const int64_t span = (max_rowid - min_rowid) / workers + 1;
+    std::vector<std::vector<Trace>> partitions(workers);
+
+    run_workers(workers, [&](unsigned worker) {
+        int64_t lower = min_rowid + span * worker;
+        if (lower > max_rowid) {
+            return;
+        }
+        int64_t upper = std::min(max_rowid, lower + span - 1);
+
+        Database worker_db(db_path_, true);
+        partitions[worker] = read_flat(worker_db, "rowid BETWEEN ? AND ?", {lower, upper}, allocators[worker]);
+    });
+
+    std::vector<Trace> traces;
+    std::unordered_map<std::string, size_t> case_slots;
+    for (auto& partition : partitions) {
+        for (auto& trace : partition) {
+            auto slot = case_slots.try_emplace(trace.get_case_id(), traces.size());
+            if (slot.second) {
+                traces.push_back(std::move(trace));
+                continue;
+            }
+            traces[slot.first->second].append_events(std::move(trace));
+        }
+    }
+
+    for (auto& trace : traces) {
+        log->add_trace(std::move(trace));
     }
     
-    create_table += ")";
-    
-    if (!db.execute(create_table)) {
-        throw std::runtime_error("Failed to create table: " + db.get_error_message());
+    return log;
+}
+
+CSVLogWriter::CSVLogWriter(const std::string& filepath, char delimiter)
+    : filepath_(filepath), delimiter_(delimiter),
+      compatibility_mode_(false), parallelism_(1), append_mode_(false) {}
+
+std::ofstream CSVLogWriter::open_output(bool& write_header) const {
+    std::ios::openmode mode = std::ios::binary;
+    write_header = true;
+    if (append_mode_) {
+        std::error_code error;
+        write_header = std::filesystem::file_size(filepath_, error) == 0 || error;
+        mode |= std::ios::app;
     }
 
-    db.begin_transaction();
+    std::ofstream file(filepath_, mode);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file for writing: " + filepath_);
+    }
+    return file;
+}
 
-    std::string insert_sql = "INSERT INTO " + table_name_ + " (case_id, activity, timestamp, resource";
-    
-    for (const auto& attr_name : attribute_names) {
-        insert_sql += ", " + attr_name;
+void CSVLogWriter::write(const EventLog& log) {
+    PROCMINE_TRACE_SCOPE("csv.write");
+    constexpr size_t buffer_size = 1 << 20;
+    constexpr size_t traces_per_chunk = 4096;
+
+    bool write_header;
+    std::ofstream file = open_output(write_header);
+    PROCMINE_COUNTER_ADD("csv.events_written", log.event_count());
+
+    auto write_buffer = [&](std::string& buffer) {
+        PROCMINE_COUNTER_ADD("csv.bytes_written", buffer.size());
+        file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        if (!file) {
+            throw std::runtime_error("Failed to write file: " + filepath_);
+        }
+        buffer.clear();
+    };
+
+    const auto attribute_names = attribute_columns(log);
+    CSVRowFormatter formatter(delimiter_, attribute_names, AttributeLookup(log, attribute_names));
+
+    std::string buffer;
+    buffer.reserve(buffer_size + 4096);
+    if (write_header) {
+        formatter.append_header(buffer);
     }
-    
-    insert_sql += ") VALUES (?, ?, ?, ?";
-    
-    for (size_t i = 0; i < attribute_names.size(); ++i) {
-        insert_sql += ", ?";
+
+    const auto& traces = log.get_traces();
+    const unsigned workers = resolve_thread_count(parallelism_);
+
+    if (workers == 1) {
+        for (const auto& trace : traces) {
+            for (const auto& event : trace.get_events()) {
+                formatter.append_row(buffer, trace.get_case_id(), event);
+                if (buffer.size() >= buffer_size) {
+                    write_buffer(buffer);
+                }
+            }
+        }
+        write_buffer(buffer);
+        return;
+    }
+
+    write_buffer(buffer);
+
+    std::vector<CSVRowFormatter> formatters(workers, formatter);
+    std::vector<std::string> chunks(workers);
+    const size_t round_size = traces_per_chunk * workers;
+
+    for (size_t round = 0; round < traces.size(); round += round_size) {
+        run_workers(workers, [&](unsigned worker) {
+            size_t first = std::min(traces.size(), round + worker * traces_per_chunk);
+            size_t last = std::min(traces.size(), first + traces_per_chunk);
+            for (size_t t = first; t < last; ++t) {
+                for (const auto& event : traces[t].get_events()) {
+                    formatters[worker].append_row(chunks[worker], traces[t].get_case_id(), event);
+                }
+            }
+        });
+
+        for (auto& chunk : chunks) {
+            write_buffer(chunk);
+        }
+    }
+}
+
+void CSVLogWriter::set_compatibility_mode(bool enabled) {
+    compatibility_mode_ = enabled;
+}
+
+void CSVLogWriter::set_parallelism(unsigned threads) {
+    parallelism_ = threads;
+}
+
+void CSVLogWriter::set_append_mode(bool enabled) {
+    append_mode_ = enabled;
+}
+
+std::vector<std::string> CSVLogWriter::attribute_columns(const EventLog& log) const {
+    auto attribute_names = collect_attribute_names(log);
+    if (!compatibility_mode_) {
+        std::sort(attribute_names.begin(), attribute_names.end());
+    }
+    return attribute_names;
+}
+
+std::future<void> CSVLogWriter::write_async(std::shared_ptr<const EventLog> log, size_t queue_capacity) {
+    return std::async(std::launch::async, [writer = *this, log, queue_capacity]() {
+        writer.write_pipelined(*log, queue_capacity);
+    });
+}
+
+void CSVLogWriter::write_pipelined(const EventLog& log, size_t queue_capacity) const {
+    PROCMINE_TRACE_SCOPE("csv.write");
+    constexpr size_t buffer_size = 1 << 20;
+
+    bool write_header;
+    std::ofstream file = open_output(write_header);
+    PROCMINE_COUNTER_ADD("csv.events_written", log.event_count());
+
+    BoundedQueue<std::string> filled(queue_capacity);
+    BoundedQueue<std::string> recycled(queue_capacity + 2);
+    std::exception_ptr io_error;
+    std::atomic<bool> aborted(false);
+
+    std::thread io_thread([&] {
+        try {
+            while (auto buffer = filled.pop()) {
+                if (aborted) {
+                    return;
+                }
+                PROCMINE_COUNTER_ADD("csv.bytes_written", buffer->size());
+                file.write(buffer->data(), static_cast<std::streamsize>(buffer->size()));
+                if (!file) {
+                    throw std::runtime_error("Failed to write file: " + filepath_);
+                }
+                buffer->clear();
+                recycled.try_push(std::move(*buffer));
+            }
+            file.flush();
+        } catch (...) {
+            io_error = std::current_exception();
+            filled.close();
+        }
+    });
+
+    auto next_buffer = [&] {
+        auto buffer = recycled.try_pop();
+        if (buffer) {
+            return std::move(*buffer);
+        }
+        std::string fresh;
+        fresh.reserve(buffer_size + 4096);
+        return fresh;
+    };
+
+    try {
+        const auto attribute_names = attribute_columns(log);
+        CSVRowFormatter formatter(delimiter_, attribute_names, AttributeLookup(log, attribute_names));
+
+        std::string buffer = next_buffer();
+        if (write_header) {
+            formatter.append_header(buffer);
+        }
+
+        bool queue_open = true;
+        for (const auto& trace : log.get_traces()) {
+            for (const auto& event : trace.get_events()) {
+                formatter.append_row(buffer, trace.get_case_id(), event);
+                if (buffer.size() >= buffer_size) {
+                    queue_open = filled.push(std::move(buffer));
+                    if (!queue_open) {
+                        break;
+                    }
+                    buffer = next_buffer();
+                }
+            }
+            if (!queue_open) {
+                break;
+            }
+        }
+
+        if (queue_open && !buffer.empty()) {
+            filled.push(std::move(buffer));
+        }
+    } catch (...) {
+        aborted = true;
+        filled.close();
+        io_thread.join();
+        throw;
+    }
+
+    filled.close();
+    io_thread.join();
+
+    if (io_error) {
+        std::rethrow_exception(io_error);
+    }
+}
+
+SQLiteLogWriter::SQLiteLogWriter(const std::string& db_path, const std::string& table_name)
+    : db_path_(db_path), table_name_(table_name), layout_(SQLiteLayout::Flat),
+      bulk_mode_(false), batch_size_(512), create_indexes_(false) {}
+
+void SQLiteLogWriter::write(const EventLog& log) {
+    PROCMINE_TRACE_SCOPE("sqlite.write");
+    PROCMINE_COUNTER_ADD("sqlite.events_written", log.event_count());
+    Database db(db_path_);
+
+    if (layout_ == SQLiteLayout::Normalized) {
+        write_normalized(db, log);
+        return;
+    }
+
+    const auto attribute_names = collect_attribute_names(log);
+    create_flat_table(db, table_name_, attribute_names);
+
+    if (bulk_mode_) {
+        write_bulk(db, log, attribute_names);
+        return;
     }
-    
-    insert_sql += ")";
-    
-    auto stmt = db.prepare(insert_sql);
+
+    if (create_indexes_) {
+        create_indexes(db);
+    }
+
+    db.begin_transaction();
+
+    auto stmt = db.prepare(build_flat_insert(table_name_, attribute_names, 1));
+    AttributeLookup lookup(log, attribute_names);
+    std::string scratch;
 
     for (const auto& trace : log.get_traces()) {
         for (const auto& event : trace.get_events()) {
@@ -345,10 +1303,10 @@ void SQLiteLogWriter::write(const EventLog& log) {
             stmt->bind(param_index++, std::string(timestamp_str));
             stmt->bind(param_index++, event.resource);
 
-            for (const auto& attr_name : attribute_names) {
-                auto it = event.attributes.find(attr_name);
-                if (it != event.attributes.end()) {
-                    stmt->bind(param_index++, it->second);
+            for (size_t i = 0; i < attribute_names.size(); ++i) {
+                const std::string* value = lookup.find(event, i, scratch);
+                if (value != nullptr) {
+                    stmt->bind(param_index++, *value);
                 } else {
                     stmt->bind(param_index++, nullptr);
                 }
@@ -364,4 +1322,391 @@ void SQLiteLogWriter::write(const EventLog& log) {
     db.commit();
 }
 
+std::future<void> SQLiteLogWriter::write_async(std::shared_ptr<const EventLog> log, size_t queue_capacity) {
+    return std::async(std::launch::async, [writer = *this, log, queue_capacity]() mutable {
+        writer.write_pipelined(*log, queue_capacity);
+    });
+}
+
+void SQLiteLogWriter::set_bulk_mode(bool enabled) {
+    bulk_mode_ = enabled;
+}
+
+void SQLiteLogWriter::set_batch_size(size_t rows) {
+    batch_size_ = std::max<size_t>(1, rows);
+}
+
+void SQLiteLogWriter::set_create_indexes(bool enabled) {
+    create_indexes_ = enabled;
+}
+
+void SQLiteLogWriter::set_layout(SQLiteLayout layout) {
+    layout_ = layout;
+}
+
+void SQLiteLogWriter::write_bulk(Database& db, const EventLog& log,
+                                 const std::vector<std::string>& attribute_names) {
+    const size_t columns = 4 + attribute_names.size();
+    const size_t max_rows = std::max<size_t>(1, db.get_variable_limit() / columns);
+    const size_t rows_per_batch = std::min(batch_size_, max_rows);
+
+    BulkLoadPragmas pragmas(db);
+
+    if (!db.begin_transaction()) {
+        throw std::runtime_error("Failed to begin transaction: " + db.get_error_message());
+    }
+
+    auto batch_stmt = db.prepare(build_flat_insert(table_name_, attribute_names, rows_per_batch));
+
+    struct PendingRow {
+        const Trace* trace;
+        const Event* event;
+    };
+    std::vector<PendingRow> pending;
+    pending.reserve(rows_per_batch);
+    std::vector<std::string> timestamps(rows_per_batch);
+    std::vector<std::string> scratch(rows_per_batch * attribute_names.size());
+    AttributeLookup lookup(log, attribute_names);
+    TimestampFormatter formatter;
+
+    auto flush = [&](Database::Statement& stmt) {
+        int param_index = 1;
+        for (size_t row = 0; row < pending.size(); ++row) {
+            const Event& event = *pending[row].event;
+
+            timestamps[row].assign(formatter.format(event.timestamp));
+
+            stmt.bind_static(param_index++, pending[row].trace->get_case_id());
+            stmt.bind_static(param_index++, event.activity);
+            stmt.bind_static(param_index++, timestamps[row]);
+            stmt.bind_static(param_index++, event.resource);
+
+            for (size_t i = 0; i < attribute_names.size(); ++i) {
+                const std::string* value = lookup.find(event, i, scratch[row * attribute_names.size() + i]);
+                if (value != nullptr) {
+                    stmt.bind_static(param_index++, *value);
+                } else {
+                    stmt.bind(param_index++, nullptr);
+                }
+            }
+        }
+
+        if (!stmt.execute()) {
+            std::string error = db.get_error_message();
+            db.rollback();
+            throw std::runtime_error("Failed to insert data: " + error);
+        }
+        pending.clear();
+    };
+
+    for (const auto& trace : log.get_traces()) {
+        for (const auto& event : trace.get_events()) {
+            pending.push_back({&trace, &event});
+            if (pending.size() == rows_per_batch) {
+                flush(*batch_stmt);
+            }
+        }
+    }
+
+    if (!pending.empty()) {
+        auto tail_stmt = db.prepare(build_flat_insert(table_name_, attribute_names, pending.size()));
+        flush(*tail_stmt);
+    }
+
+    batch_stmt.reset();
+
+    if (!db.commit()) {
+        throw std::runtime_error("Failed to commit bulk load: " + db.get_error_message());
+    }
+
+    if (create_indexes_) {
+        create_indexes(db);
+    }
+}
+
+void SQLiteLogWriter::write_pipelined(const EventLog& log, size_t queue_capacity) {
+    Database db(db_path_);
+
+    if (layout_ == SQLiteLayout::Normalized) {
+        write_normalized(db, log);
+        return;
+    }
+
+    const auto attribute_names = collect_attribute_names(log);
+    create_flat_table(db, table_name_, attribute_names);
+
+    const size_t columns = 4 + attribute_names.size();
+    const size_t max_rows = std::max<size_t>(1, db.get_variable_limit() / columns);
+    const size_t rows_per_batch = std::min(batch_size_, max_rows);
+
+    std::optional<BulkLoadPragmas> pragmas;
+    if (bulk_mode_) {
+        pragmas.emplace(db);
+    } else if (create_indexes_) {
+        create_indexes(db);
+    }
+
+    struct RowBatch {
+        std::vector<std::string> values;
+        std::vector<char> nulls;
+        size_t rows = 0;
+    };
+
+    BoundedQueue<RowBatch> filled(queue_capacity);
+    BoundedQueue<RowBatch> recycled(queue_capacity + 2);
+    std::exception_ptr io_error;
+    std::atomic<bool> aborted(false);
+
+    std::thread io_thread([&] {
+        try {
+            if (!db.begin_transaction()) {
+                throw std::runtime_error("Failed to begin transaction: " + db.get_error_message());
+            }
+
+            auto batch_stmt = db.prepare(build_flat_insert(table_name_, attribute_names, rows_per_batch));
+
+            while (auto batch = filled.pop()) {
+                if (aborted) {
+                    break;
+                }
+                std::shared_ptr<Database::Statement> tail_stmt;
+                Database::Statement* stmt = batch_stmt.get();
+                if (batch->rows != rows_per_batch) {
+                    tail_stmt = db.prepare(build_flat_insert(table_name_, attribute_names, batch->rows));
+                    stmt = tail_stmt.get();
+                }
+
+                const size_t params = batch->rows * columns;
+                for (size_t i = 0; i < params; ++i) {
+                    if (batch->nulls[i]) {
+                        stmt->bind(static_cast<int>(i) + 1, nullptr);
+                    } else {
+                        stmt->bind_static(static_cast<int>(i) + 1, batch->values[i]);
+                    }
+                }
+
+                if (!stmt->execute()) {
+                    throw std::runtime_error("Failed to insert data: " + db.get_error_message());
+                }
+
+                batch->rows = 0;
+                recycled.try_push(std::move(*batch));
+            }
+
+            batch_stmt.reset();
+
+            if (aborted) {
+                db.rollback();
+                return;
+            }
+            if (!db.commit()) {
+                throw std::runtime_error("Failed to commit: " + db.get_error_message());
+            }
+        } catch (...) {
+            io_error = std::current_exception();
+            db.rollback();
+            filled.close();
+        }
+    });
+
+    auto next_batch = [&] {
+        auto batch = recycled.try_pop();
+        if (batch) {
+            return std::move(*batch);
+        }
+        RowBatch fresh;
+        fresh.values.resize(rows_per_batch * columns);
+        fresh.nulls.resize(rows_per_batch * columns);
+        return fresh;
+    };
+
+    try {
+        AttributeLookup lookup(log, attribute_names);
+        TimestampFormatter formatter;
+        RowBatch batch = next_batch();
+        bool queue_open = true;
+
+        for (const auto& trace : log.get_traces()) {
+            for (const auto& event : trace.get_events()) {
+                size_t offset = batch.rows * columns;
+
+                batch.values[offset].assign(trace.get_case_id());
+                batch.values[offset + 1].assign(event.activity);
+                batch.values[offset + 2].assign(formatter.format(event.timestamp));
+                batch.values[offset + 3].assign(event.resource);
+                std::fill_n(batch.nulls.begin() + offset, 4, 0);
+
+                for (size_t i = 0; i < attribute_names.size(); ++i) {
+                    std::string& slot = batch.values[offset + 4 + i];
+                    const std::string* value = lookup.find(event, i, slot);
+                    batch.nulls[offset + 4 + i] = value == nullptr;
+                    if (value != nullptr && value != &slot) {
+                        slot.assign(*value);
+                    }
+                }
+
+                if (++batch.rows == rows_per_batch) {
+                    queue_open = filled.push(std::move(batch));
+                    if (!queue_open) {
+                        break;
+                    }
+                    batch = next_batch();
+                }
+            }
+            if (!queue_open) {
+                break;
+            }
+        }
+
+        if (queue_open && batch.rows > 0) {
+            filled.push(std::move(batch));
+        }
+    } catch (...) {
+        aborted = true;
+        filled.close();
+        io_thread.join();
+        throw;
+    }
+
+    filled.close();
+    io_thread.join();
+
+    if (io_error) {
+        std::rethrow_exception(io_error);
+    }
+
+    if (bulk_mode_ && create_indexes_) {
+        create_indexes(db);
+    }
+}
+
+void SQLiteLogWriter::write_normalized(Database& db, const EventLog& log) {
+    const std::string events_table = Database::quote_identifier(table_name_);
+    const std::string attributes_table = dimension_table(table_name_, "attributes");
+
+    std::string schema;
+    for (const char* suffix : {"cases", "activities", "resources", "attribute_names"}) {
+        schema += "CREATE TABLE IF NOT EXISTS " + dimension_table(table_name_, suffix)
+                + " (id INTEGER PRIMARY KEY, name TEXT NOT NULL UNIQUE);";
+    }
+    schema += "CREATE TABLE IF NOT EXISTS " + events_table + " ("
+            + "id INTEGER PRIMARY KEY, "
+            + "case_ref INTEGER NOT NULL, "
+            + "activity_ref INTEGER NOT NULL, "
+            + "resource_ref INTEGER, "
+            + "timestamp INTEGER);";
+    schema += "CREATE TABLE IF NOT EXISTS " + attributes_table + " ("
+            + "event_ref INTEGER NOT NULL, "
+            + "name_ref INTEGER NOT NULL, "
+            + "value TEXT, "
+            + "PRIMARY KEY (event_ref, name_ref)) WITHOUT ROWID;";
+
+    if (!db.execute(schema)) {
+        throw std::runtime_error("Failed to create tables: " + db.get_error_message());
+    }
+
+    std::optional<BulkLoadPragmas> pragmas;
+    if (bulk_mode_) {
+        pragmas.emplace(db);
+    } else if (create_indexes_) {
+        create_indexes(db);
+    }
+
+    if (!db.begin_transaction()) {
+        throw std::runtime_error("Failed to begin transaction: " + db.get_error_message());
+    }
+
+    try {
+        NormalizedDimension cases(db, dimension_table(table_name_, "cases"));
+        NormalizedDimension activities(db, dimension_table(table_name_, "activities"));
+        NormalizedDimension resources(db, dimension_table(table_name_, "resources"));
+        NormalizedDimension attribute_names(db, dimension_table(table_name_, "attribute_names"));
+
+        auto max_id = db.prepare("SELECT COALESCE(MAX(id), 0) FROM " + events_table);
+        int64_t event_id = max_id->step() ? max_id->column_int64(0) + 1 : 1;
+        max_id.reset();
+
+        auto insert_event = db.prepare("INSERT INTO " + events_table
+                                       + " (id, case_ref, activity_ref, resource_ref, timestamp)"
+                                       + " VALUES (?, ?, ?, ?, ?)");
+        auto insert_attribute = db.prepare("INSERT INTO " + attributes_table
+                                           + " (event_ref, name_ref, value) VALUES (?, ?, ?)");
+        auto write_attribute = [&](int64_t event_ref, const std::string& name, const std::string& value) {
+            insert_attribute->bind(1, event_ref);
+            insert_attribute->bind(2, attribute_names.id_for(name));
+            insert_attribute->bind_static(3, value);
+            if (!insert_attribute->execute()) {
+                throw std::runtime_error("Failed to insert attribute: " + db.get_error_message());
+            }
+        };
+
+        const AttributeSchema* schema = log.get_attribute_schema().get();
+        std::string scratch;
+
+        for (const auto& trace : log.get_traces()) {
+            int64_t case_ref = cases.id_for(trace.get_case_id());
+
+            for (const auto& event : trace.get_events()) {
+                insert_event->bind(1, event_id);
+                insert_event->bind(2, case_ref);
+                insert_event->bind(3, activities.id_for(event.activity));
+                if (event.resource.empty()) {
+                    insert_event->bind(4, nullptr);
+                } else {
+                    insert_event->bind(4, resources.id_for(event.resource));
+                }
+                insert_event->bind(5, static_cast<int64_t>(
+                    std::chrono::duration_cast<std::chrono::seconds>(
+                        event.timestamp.time_since_epoch()).count()));
+
+                if (!insert_event->execute()) {
+                    throw std::runtime_error("Failed to insert data: " + db.get_error_message());
+                }
+
+                for (const auto& attr : event.attributes) {
+                    write_attribute(event_id, attr.first, attr.second);
+                }
+                if (schema && event.attribute_row != Event::no_attribute_row) {
+                    for (size_t i = 0; i < schema->column_count(); ++i) {
+                        const AttributeColumn& column = schema->get_column(i);
+                        if (!event.attributes.count(column.get_name()) &&
+                            column.format(event.attribute_row, scratch)) {
+                            write_attribute(event_id, column.get_name(), scratch);
+                        }
+                    }
+                }
+
+                ++event_id;
+            }
+        }
+    } catch (...) {
+        db.rollback();
+        throw;
+    }
+
+    if (!db.commit()) {
+        throw std::runtime_error("Failed to commit: " + db.get_error_message());
+    }
+
+    if (bulk_mode_ && create_indexes_) {
+        create_indexes(db);
+    }
+}
+
+void SQLiteLogWriter::create_indexes(Database& db) {
+    std::vector<std::string> columns = {"case_id", "activity"};
+    if (layout_ == SQLiteLayout::Normalized) {
+        columns = {"case_ref", "activity_ref"};
+    }
+
+    for (const auto& column : columns) {
+        std::string sql = "CREATE INDEX IF NOT EXISTS "
+                        + Database::quote_identifier("idx_" + table_name_ + "_" + column)
+                        + " ON " + Database::quote_identifier(table_name_) + " (" + column + ")";
+        if (!db.execute(sql)) {
+            throw std::runtime_error("Failed to create index: " + db.get_error_message());
+        }
+    }
+}
+
 }
@@ -1,10 +1,360 @@
 #include "procmine/models.h"
+#include "procmine/instrumentation.h"
+#include <algorithm>
+#include <charconv>
+#include <ctime>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
 #include <unordered_set>
 
 namespace procmine {
 
+namespace {
+
+template <typename T>
+bool try_parse_number(std::string_view value, T& result) {
+    auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), result);
+    return error == std::errc() && end == value.data() + value.size();
+}
+
+bool try_parse_seconds(std::string_view value, int64_t& result) {
+    std::tm tm = {};
+    std::istringstream stream{std::string(value)};
+    stream >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
+    if (stream.fail()) {
+        stream.clear();
+        stream.str(std::string(value));
+        stream >> std::get_time(&tm, "%Y-%m-%dT%H:%M:%S");
+    }
+    if (stream.fail()) {
+        return false;
+    }
+    tm.tm_isdst = -1;
+    result = static_cast<int64_t>(std::mktime(&tm));
+    return true;
+}
+
+template <typename T>
+T parse_number(const std::string& column, std::string_view value) {
+    T result{};
+    if (!try_parse_number(value, result)) {
+        throw std::runtime_error("Invalid value for attribute " + column + ": " + std::string(value));
+    }
+    return result;
+}
+
+int64_t parse_seconds(const std::string& column, std::string_view value) {
+    int64_t result = 0;
+    if (!try_parse_seconds(value, result)) {
+        throw std::runtime_error("Invalid value for attribute " + column + ": " + std::string(value));
+    }
+    return result;
+}
+
+}
+
+AttributeColumn::AttributeColumn(const std::string& name, AttributeType type)
+    : name_(name), type_(type), size_(0) {}
+
+const std::string& AttributeColumn::get_name() const {
+    return name_;
+}
+
+AttributeType AttributeColumn::get_type() const {
+    return type_;
+}
+
+size_t AttributeColumn::size() const {
+    return size_;
+}
+
+void AttributeColumn::resize(size_t rows) {
+    if (rows <= size_) {
+        return;
+    }
+    size_ = rows;
+    valid_.resize((rows + 63) / 64, 0);
+    switch (type_) {
+        case AttributeType::String:
+            codes_.resize(rows, 0);
+            break;
+        case AttributeType::Double:
+            doubles_.resize(rows, 0.0);
+            break;
+        default:
+            integers_.resize(rows, 0);
+            break;
+    }
+}
+
+void AttributeColumn::set(size_t row, std::string_view value) {
+    if (type_ != AttributeType::String && value.empty()) {
+        set_null(row);
+        return;
+    }
+
+    resize(row + 1);
+    switch (type_) {
+        case AttributeType::String: {
+            auto it = lookup_.find(std::string(value));
+            if (it == lookup_.end()) {
+                if (dictionary_.size() >= UINT32_MAX) {
+                    throw std::runtime_error("Too many distinct values for attribute " + name_);
+                }
+                it = lookup_.emplace(std::string(value), static_cast<uint32_t>(dictionary_.size())).first;
+                dictionary_.emplace_back(value);
+            }
+            codes_[row] = it->second;
+            break;
+        }
+        case AttributeType::Int64:
+            integers_[row] = parse_number<int64_t>(name_, value);
+            break;
+        case AttributeType::Double:
+            doubles_[row] = parse_number<double>(name_, value);
+            break;
+        case AttributeType::Timestamp:
+            integers_[row] = parse_seconds(name_, value);
+            break;
+    }
+    valid_[row / 64] |= uint64_t(1) << (row % 64);
+}
+
+void AttributeColumn::set_null(size_t row) {
+    resize(row + 1);
+    valid_[row / 64] &= ~(uint64_t(1) << (row % 64));
+}
+
+bool AttributeColumn::is_null(size_t row) const {
+    return row >= size_ || !((valid_[row / 64] >> (row % 64)) & 1);
+}
+
+uint32_t AttributeColumn::get_code(size_t row) const {
+    return codes_[row];
+}
+
+int64_t AttributeColumn::get_int64(size_t row) const {
+    return integers_[row];
+}
+
+double AttributeColumn::get_double(size_t row) const {
+    return doubles_[row];
+}
+
+std::chrono::system_clock::time_point AttributeColumn::get_timestamp(size_t row) const {
+    return std::chrono::system_clock::time_point(std::chrono::seconds(integers_[row]));
+}
+
+const std::vector<std::string>& AttributeColumn::get_dictionary() const {
+    return dictionary_;
+}
+
+bool AttributeColumn::find_code(std::string_view value, uint32_t& code) const {
+    auto it = lookup_.find(std::string(value));
+    if (it == lookup_.end()) {
+        return false;
+    }
+    code = it->second;
+    return true;
+}
+
+bool AttributeColumn::format(size_t row, std::string& out) const {
+    if (is_null(row)) {
+        return false;
+    }
+
+    switch (type_) {
+        case AttributeType::String:
+            out.assign(dictionary_[codes_[row]]);
+            break;
+        case AttributeType::Int64:
+            out = std::to_string(integers_[row]);
+            break;
+        case AttributeType::Double: {
+            char buffer[32];
+            auto result = std::to_chars(buffer, buffer + sizeof(buffer), doubles_[row]);
+            out.assign(buffer, result.ptr);
+            break;
+        }
+        case AttributeType::Timestamp: {
+            std::time_t time = static_cast<std::time_t>(integers_[row]);
+            std::tm tm = {};
+            localtime_r(&time, &tm);
+            char buffer[20];
+            out.assign(buffer, std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &tm));
+            break;
+        }
+    }
+    return true;
+}
+
+std::vector<uint8_t> AttributeColumn::equals(std::string_view value) const {
+    std::vector<uint8_t> matches(size_, 0);
+    if (type_ != AttributeType::String && value.empty()) {
+        return matches;
+    }
+
+    switch (type_) {
+        case AttributeType::String: {
+            uint32_t code;
+            if (!find_code(value, code)) {
+                return matches;
+            }
+            for (size_t row = 0; row < size_; ++row) {
+                matches[row] = codes_[row] == code;
+            }
+            break;
+        }
+        case AttributeType::Double: {
+            double target = 0.0;
+            if (!try_parse_number(value, target)) {
+                return matches;
+            }
+            for (size_t row = 0; row < size_; ++row) {
+                matches[row] = doubles_[row] == target;
+            }
+            break;
+        }
+        default: {
+            int64_t target = 0;
+            bool parsed = type_ == AttributeType::Int64 ? try_parse_number(value, target)
+                                                        : try_parse_seconds(value, target);
+            if (!parsed) {
+                return matches;
+            }
+            for (size_t row = 0; row < size_; ++row) {
+                matches[row] = integers_[row] == target;
+            }
+            break;
+        }
+    }
+
+    for (size_t row = 0; row < size_; ++row) {
+        matches[row] &= static_cast<uint8_t>((valid_[row / 64] >> (row % 64)) & 1);
+    }
+    return matches;
+}
+
+size_t AttributeColumn::memory_usage() const {
+    size_t bytes = valid_.capacity() * sizeof(uint64_t)
+                 + codes_.capacity() * sizeof(uint32_t)
+                 + integers_.capacity() * sizeof(int64_t)
+                 + doubles_.capacity() * sizeof(double);
+    for (const auto& value : dictionary_) {
+        bytes += sizeof(std::string) + (value.capacity() > 15 ? value.capacity() : 0);
+    }
+    return bytes + lookup_.size() * (sizeof(std::string) + sizeof(uint32_t) + 2 * sizeof(void*));
+}
+
+AttributeSchema::AttributeSchema() : rows_(0) {}
+
+size_t AttributeSchema::add_column(const std::string& name, AttributeType type) {
+    auto it = index_.find(name);
+    if (it != index_.end()) {
+        if (columns_[it->second].get_type() != type) {
+            throw std::runtime_error("Attribute " + name + " already exists with a different type");
+        }
+        return it->second;
+    }
+    columns_.emplace_back(name, type);
+    index_.emplace(name, columns_.size() - 1);
+    return columns_.size() - 1;
+}
+
+const AttributeColumn* AttributeSchema::find_column(const std::string& name) const {
+    auto it = index_.find(name);
+    return it == index_.end() ? nullptr : &columns_[it->second];
+}
+
+size_t AttributeSchema::column_index(const std::string& name) const {
+    auto it = index_.find(name);
+    if (it == index_.end()) {
+        throw std::runtime_error("Unknown attribute: " + name);
+    }
+    return it->second;
+}
+
+size_t AttributeSchema::column_count() const {
+    return columns_.size();
+}
+
+const AttributeColumn& AttributeSchema::get_column(size_t index) const {
+    return columns_[index];
+}
+
+uint32_t AttributeSchema::add_row() {
+    if (rows_ >= Event::no_attribute_row) {
+        throw std::runtime_error("Attribute schema row limit reached");
+    }
+    return static_cast<uint32_t>(rows_++);
+}
+
+size_t AttributeSchema::row_count() const {
+    return rows_;
+}
+
+void AttributeSchema::set(uint32_t row, size_t column, std::string_view value) {
+    if (row >= rows_) {
+        throw std::out_of_range("Attribute row out of range");
+    }
+    columns_[column].set(row, value);
+}
+
+std::unordered_map<std::string, std::string> AttributeSchema::get_attributes(uint32_t row) const {
+    std::unordered_map<std::string, std::string> attributes;
+    std::string value;
+    for (const auto& column : columns_) {
+        if (column.format(row, value)) {
+            attributes.emplace(column.get_name(), value);
+        }
+    }
+    return attributes;
+}
+
+size_t AttributeSchema::memory_usage() const {
+    size_t bytes = 0;
+    for (const auto& column : columns_) {
+        bytes += column.memory_usage();
+    }
+    return bytes;
+}
+
+Event::Event(const allocator_type& allocator) : attributes(allocator) {}
+
+Event::Event(const Event& other, const allocator_type& allocator)
+    : activity(other.activity), resource(other.resource), timestamp(other.timestamp),
+      attributes(other.attributes, allocator), attribute_row(other.attribute_row) {}
+
+Event::Event(Event&& other, const allocator_type& allocator)
+    : activity(std::move(other.activity)), resource(std::move(other.resource)), timestamp(other.timestamp),
+      attributes(std::move(other.attributes), allocator), attribute_row(other.attribute_row) {}
+
+Event::allocator_type Event::get_allocator() const {
+    return attributes.get_allocator();
+}
+
 Trace::Trace(const std::string& case_id) : case_id_(case_id) {}
 
+Trace::Trace(const std::string& case_id, const allocator_type& allocator)
+    : case_id_(case_id), events_(allocator) {}
+
+Trace::Trace(const Trace& other, const allocator_type& allocator)
+    : case_id_(other.case_id_), events_(other.events_, allocator), attributes_(other.attributes_) {}
+
+Trace::Trace(Trace&& other, const allocator_type& allocator)
+    : case_id_(std::move(other.case_id_)), events_(std::move(other.events_), allocator),
+      attributes_(std::move(other.attributes_)) {}
+
+Trace::allocator_type Trace::get_allocator() const {
+    return events_.get_allocator();
+}
+
+void Trace::reserve(size_t events) {
+    events_.reserve(events);
+}
+
 void Trace::add_event(const Event& event) {
     events_.push_back(event);
 }
@@ -13,11 +363,29 @@ void Trace::add_event(Event&& event) {
     events_.push_back(std::move(event));
 }
 
+void Trace::expand_attributes(const AttributeSchema& schema) {
+    for (auto& event : events_) {
+        if (event.attribute_row == Event::no_attribute_row) {
+            continue;
+        }
+        for (auto& attr : schema.get_attributes(event.attribute_row)) {
+            event.attributes.try_emplace(attr.first, std::move(attr.second));
+        }
+        event.attribute_row = Event::no_attribute_row;
+    }
+}
+
+void Trace::append_events(Trace&& other) {
+    events_.reserve(events_.size() + other.events_.size());
+    std::move(other.events_.begin(), other.events_.end(), std::back_inserter(events_));
+    other.events_.clear();
+}
+
 const std::string& Trace::get_case_id() const {
     return case_id_;
 }
 
-const std::vector<Event>& Trace::get_events() const {
+const std::pmr::vector<Event>& Trace::get_events() const {
     return events_;
 }
 
@@ -33,20 +401,221 @@ void Trace::set_attribute(const std::string& key, const std::string& value) {
     attributes_[key] = value;
 }
 
-EventLog::EventLog() {}
+const std::unordered_map<std::string, std::string>& Trace::get_attributes() const {
+    return attributes_;
+}
+
+namespace {
+
+bool entry_before(const TimeIndex::Entry& a, const TimeIndex::Entry& b) {
+    if (a.timestamp != b.timestamp) {
+        return a.timestamp < b.timestamp;
+    }
+    if (a.trace != b.trace) {
+        return a.trace < b.trace;
+    }
+    return a.event < b.event;
+}
+
+void append_range(const std::vector<TimeIndex::Entry>& entries,
+                  const std::chrono::system_clock::time_point& start,
+                  const std::chrono::system_clock::time_point& end,
+                  std::vector<TimeIndex::Entry>& result) {
+    auto first = std::lower_bound(entries.begin(), entries.end(), start,
+                                  [](const TimeIndex::Entry& e, const auto& t) { return e.timestamp < t; });
+    auto last = std::upper_bound(first, entries.end(), end,
+                                 [](const auto& t, const TimeIndex::Entry& e) { return t < e.timestamp; });
+    result.insert(result.end(), first, last);
+}
+
+}
+
+TimeIndex::TimeIndex() {}
+
+void TimeIndex::add_trace(const Trace& trace, size_t trace_index) {
+    const auto& events = trace.get_events();
+    if (trace_index > UINT32_MAX || events.size() > UINT32_MAX) {
+        throw std::runtime_error("Event log too large for time index");
+    }
+
+    if (bounds_.size() <= trace_index) {
+        bounds_.resize(trace_index + 1, Bounds{std::chrono::system_clock::time_point::max(),
+                                               std::chrono::system_clock::time_point::min()});
+    }
+    if (events.empty()) {
+        return;
+    }
+
+    std::vector<Entry> added;
+    added.reserve(events.size());
+    for (size_t i = 0; i < events.size(); ++i) {
+        added.push_back({events[i].timestamp, static_cast<uint32_t>(trace_index), static_cast<uint32_t>(i)});
+    }
+    if (!std::is_sorted(added.begin(), added.end(), entry_before)) {
+        std::sort(added.begin(), added.end(), entry_before);
+    }
+    bounds_[trace_index] = Bounds{added.front().timestamp, added.back().timestamp};
+
+    if (entries_.empty() || !entry_before(added.front(), entries_.back())) {
+        entries_.insert(entries_.end(), added.begin(), added.end());
+        return;
+    }
+
+    size_t middle = tail_.size();
+    tail_.insert(tail_.end(), added.begin(), added.end());
+    std::inplace_merge(tail_.begin(), tail_.begin() + middle, tail_.end(), entry_before);
+
+    if (tail_.size() > std::max<size_t>(4096, entries_.size() / 8)) {
+        merge_tail();
+    }
+}
+
+void TimeIndex::merge_tail() {
+    size_t middle = entries_.size();
+    entries_.insert(entries_.end(), tail_.begin(), tail_.end());
+    std::inplace_merge(entries_.begin(), entries_.begin() + middle, entries_.end(), entry_before);
+    tail_.clear();
+}
+
+size_t TimeIndex::size() const {
+    return entries_.size() + tail_.size();
+}
+
+const std::vector<TimeIndex::Bounds>& TimeIndex::get_bounds() const {
+    return bounds_;
+}
+
+bool TimeIndex::overlaps(size_t trace_index,
+                         const std::chrono::system_clock::time_point& start,
+                         const std::chrono::system_clock::time_point& end) const {
+    const Bounds& bounds = bounds_[trace_index];
+    return bounds.first <= end && bounds.last >= start;
+}
+
+std::vector<TimeIndex::Entry> TimeIndex::range(const std::chrono::system_clock::time_point& start,
+                                               const std::chrono::system_clock::time_point& end) const {
+    std::vector<Entry> result;
+    if (end < start) {
+        return result;
+    }
+    append_range(entries_, start, end, result);
+    append_range(tail_, start, end, result);
+    return result;
+}
+
+EventLog::EventLog() : resource_(nullptr) {}
+
+EventLog::EventLog(const EventLog& other)
+    : resource_(nullptr), traces_(other.traces_), time_index_(other.time_index_),
+      attribute_schema_(other.attribute_schema_ ? std::make_shared<AttributeSchema>(*other.attribute_schema_)
+                                                : nullptr) {}
+
+EventLog::EventLog(EventLog&& other) noexcept
+    : arenas_(std::move(other.arenas_)), resource_(other.resource_),
+      traces_(std::move(other.traces_)), time_index_(std::move(other.time_index_)),
+      attribute_schema_(std::move(other.attribute_schema_)) {
+    other.resource_ = nullptr;
+}
+
+EventLog& EventLog::operator=(const EventLog& other) {
+    if (this != &other) {
+        traces_ = other.traces_;
+        time_index_ = other.time_index_;
+        attribute_schema_ = other.attribute_schema_ ? std::make_shared<AttributeSchema>(*other.attribute_schema_)
+                                                    : nullptr;
+    }
+    return *this;
+}
+
+EventLog& EventLog::operator=(EventLog&& other) {
+    if (this != &other) {
+        traces_ = std::move(other.traces_);
+        time_index_ = std::move(other.time_index_);
+        attribute_schema_ = std::move(other.attribute_schema_);
+        arenas_ = std::move(other.arenas_);
+        resource_ = other.resource_;
+        other.resource_ = nullptr;
+    }
+    return *this;
+}
+
+void EventLog::use_arena(size_t initial_size) {
+    resource_ = create_arena(initial_size);
+}
+
+std::pmr::memory_resource* EventLog::create_arena(size_t initial_size) {
+    arenas_.push_back(std::make_unique<std::pmr::monotonic_buffer_resource>(
+        initial_size, arena_upstream_resource()));
+    return arenas_.back().get();
+}
+
+Trace::allocator_type EventLog::get_allocator() const {
+    return Trace::allocator_type(resource_ ? resource_ : std::pmr::get_default_resource());
+}
+
+void EventLog::check_attribute_rows(const Trace& trace) const {
+    if (attribute_schema_) {
+        return;
+    }
+    for (const auto& event : trace.get_events()) {
+        if (event.attribute_row != Event::no_attribute_row) {
+            throw std::runtime_error("Trace " + trace.get_case_id()
+                                     + " has columnar attributes but the log has no schema");
+        }
+    }
+}
 
 void EventLog::add_trace(const Trace& trace) {
-    traces_.push_back(trace);
+    check_attribute_rows(trace);
+    traces_.emplace_back(trace, get_allocator());
+    if (time_index_) {
+        time_index_->add_trace(traces_.back(), traces_.size() - 1);
+    }
 }
 
 void EventLog::add_trace(Trace&& trace) {
-    traces_.push_back(std::move(trace));
+    check_attribute_rows(trace);
+    if (owns_resource(trace.get_allocator().resource())) {
+        traces_.push_back(std::move(trace));
+    } else {
+        traces_.emplace_back(std::move(trace), get_allocator());
+    }
+    if (time_index_) {
+        time_index_->add_trace(traces_.back(), traces_.size() - 1);
+    }
+}
+
+void EventLog::add_trace(const Trace& trace, const AttributeSchema* schema) {
+    if (schema == nullptr || schema == attribute_schema_.get()) {
+        add_trace(trace);
+        return;
+    }
+    Trace copy(trace, get_allocator());
+    copy.expand_attributes(*schema);
+    add_trace(std::move(copy));
+}
+
+bool EventLog::owns_resource(const std::pmr::memory_resource* resource) const {
+    if (resource == get_allocator().resource()) {
+        return true;
+    }
+    return std::any_of(arenas_.begin(), arenas_.end(), [resource](const auto& arena) {
+        return arena.get() == resource;
+    });
 }
 
 const std::vector<Trace>& EventLog::get_traces() const {
     return traces_;
 }
 
+size_t EventLog::event_count() const {
+    size_t count = 0;
+    for (const auto& trace : traces_) {
+        count += trace.get_events().size();
+    }
+    return count;
+}
+
 std::vector<std::string> EventLog::get_activities() const {
     std::unordered_set<std::string> unique_activities;
     
@@ -60,50 +629,317 @@ std::vector<std::string> EventLog::get_activities() const {
 }
 
 std::shared_ptr<EventLog> EventLog::filter_by_activity(const std::string& activity) const {
-    auto filtered_log = std::make_shared<EventLog>();
+    return LogView(*this).filter_by_activity(activity).materialize();
+}
+
+std::shared_ptr<EventLog> EventLog::filter_by_timeframe(
+    const std::chrono::system_clock::time_point& start,
+    const std::chrono::system_clock::time_point& end) const {
+    return LogView(*this).filter_by_timeframe(start, end).materialize();
+}
+
+void EventLog::build_time_index() {
+    time_index_.emplace();
+    for (size_t i = 0; i < traces_.size(); ++i) {
+        time_index_->add_trace(traces_[i], i);
+    }
+}
+
+void EventLog::drop_time_index() {
+    time_index_.reset();
+}
+
+const TimeIndex* EventLog::get_time_index() const {
+    return time_index_ ? &*time_index_ : nullptr;
+}
+
+void EventLog::set_attribute_schema(std::shared_ptr<AttributeSchema> schema) {
+    attribute_schema_ = std::move(schema);
+}
+
+const std::shared_ptr<AttributeSchema>& EventLog::get_attribute_schema() const {
+    return attribute_schema_;
+}
+
+void EventLog::columnarize_attributes(const std::unordered_map<std::string, AttributeType>& types) {
+    if (!attribute_schema_) {
+        attribute_schema_ = std::make_shared<AttributeSchema>();
+    } else if (attribute_schema_.use_count() > 1) {
+        attribute_schema_ = std::make_shared<AttributeSchema>(*attribute_schema_);
+    }
+    AttributeSchema& schema = *attribute_schema_;
+    std::unordered_map<std::string, size_t> columns;
+
+    for (auto& trace : traces_) {
+        for (auto& event : trace.events_) {
+            if (event.attributes.empty()) {
+                continue;
+            }
+            if (event.attribute_row == Event::no_attribute_row) {
+                event.attribute_row = schema.add_row();
+            }
+            for (const auto& attr : event.attributes) {
+                auto column = columns.find(attr.first);
+                if (column == columns.end()) {
+                    auto type = types.find(attr.first);
+                    column = columns.emplace(attr.first, schema.add_column(
+                        attr.first, type == types.end() ? AttributeType::String : type->second)).first;
+                }
+                schema.set(event.attribute_row, column->second, attr.second);
+            }
+            std::pmr::unordered_map<std::string, std::string>(event.attributes.get_allocator()).swap(event.attributes);
+        }
+    }
+}
+
+bool EventLog::get_event_attribute(const Event& event, const std::string& name, std::string& value) const {
+    auto it = event.attributes.find(name);
+    if (it != event.attributes.end()) {
+        value = it->second;
+        return true;
+    }
+    if (!attribute_schema_ || event.attribute_row == Event::no_attribute_row) {
+        return false;
+    }
+    const AttributeColumn* column = attribute_schema_->find_column(name);
+    return column != nullptr && column->format(event.attribute_row, value);
+}
+
+std::unordered_map<std::string, std::string> EventLog::get_event_attributes(const Event& event) const {
+    std::unordered_map<std::string, std::string> attributes;
+    if (attribute_schema_ && event.attribute_row != Event::no_attribute_row) {
+        attributes = attribute_schema_->get_attributes(event.attribute_row);
+    }
+    for (const auto& attr : event.attributes) {
+        attributes[attr.first] = attr.second;
+    }
+    return attributes;
+}
+
+TraceView::TraceView(const Trace& trace, const std::vector<uint32_t>* selection)
+    : trace_(&trace), selection_(selection) {}
+
+const std::string& TraceView::get_case_id() const {
+    return trace_->get_case_id();
+}
+
+const Trace& TraceView::get_trace() const {
+    return *trace_;
+}
+
+size_t TraceView::size() const {
+    return selection_ ? selection_->size() : trace_->get_events().size();
+}
+
+bool TraceView::empty() const {
+    return size() == 0;
+}
+
+const Event& TraceView::operator[](size_t index) const {
+    return trace_->get_events()[event_index(index)];
+}
+
+size_t TraceView::event_index(size_t index) const {
+    return selection_ ? (*selection_)[index] : index;
+}
+
+LogView::LogView(const EventLog& log) : log_(&log), full_(true) {}
+
+LogView::LogView(const EventLog* log) : log_(log), full_(false) {}
+
+const EventLog& LogView::get_log() const {
+    return *log_;
+}
+
+size_t LogView::size() const {
+    return full_ ? log_->get_traces().size() : trace_indexes_.size();
+}
+
+bool LogView::empty() const {
+    return size() == 0;
+}
+
+size_t LogView::event_count() const {
+    if (full_) {
+        return log_->event_count();
+    }
+    size_t count = 0;
+    for (size_t i = 0; i < size(); ++i) {
+        count += get_trace(i).size();
+    }
+    return count;
+}
+
+TraceView LogView::get_trace(size_t index) const {
+    if (full_) {
+        return TraceView(log_->get_traces()[index]);
+    }
+    return TraceView(log_->get_traces()[trace_indexes_[index]], selections_[index].get());
+}
+
+size_t LogView::trace_index(size_t index) const {
+    return full_ ? index : trace_indexes_[index];
+}
+
+const std::shared_ptr<const std::vector<uint32_t>>& LogView::get_selection(size_t index) const {
+    static const std::shared_ptr<const std::vector<uint32_t>> no_selection;
+    return full_ ? no_selection : selections_[index];
+}
+
+std::vector<std::string> LogView::get_activities() const {
+    std::unordered_set<std::string> unique_activities;
     
-    for (const auto& trace : traces_) {
-        Trace filtered_trace(trace.get_case_id());
-        bool has_activity = false;
+    for (const auto& trace : *this) {
+        for (const auto& event : trace) {
+            unique_activities.insert(event.activity);
+        }
+    }
+    
+    return std::vector<std::string>(unique_activities.begin(), unique_activities.end());
+}
+
+LogView LogView::filter_traces(const std::function<bool(const TraceView&)>& predicate) const {
+    LogView result(log_);
+    
+    for (size_t i = 0; i < size(); ++i) {
+        if (predicate(get_trace(i))) {
+            result.trace_indexes_.push_back(trace_index(i));
+            result.selections_.push_back(get_selection(i));
+        }
+    }
+    
+    return result;
+}
+
+LogView LogView::filter_events(const std::function<bool(const Event&)>& predicate) const {
+    LogView result(log_);
+    
+    for (size_t i = 0; i < size(); ++i) {
+        TraceView trace = get_trace(i);
+        std::vector<uint32_t> selection;
         
-        for (const auto& event : trace.get_events()) {
-            if (event.activity == activity) {
-                has_activity = true;
-                filtered_trace.add_event(event);
+        for (size_t j = 0; j < trace.size(); ++j) {
+            if (predicate(trace[j])) {
+                selection.push_back(static_cast<uint32_t>(trace.event_index(j)));
             }
         }
         
-        if (has_activity) {
-            filtered_log->add_trace(filtered_trace);
+        if (selection.empty()) {
+            continue;
+        }
+
+        result.trace_indexes_.push_back(trace_index(i));
+        if (selection.size() == trace.get_trace().get_events().size()) {
+            result.selections_.push_back(nullptr);
+        } else {
+            result.selections_.push_back(std::make_shared<const std::vector<uint32_t>>(std::move(selection)));
         }
     }
     
-    return filtered_log;
+    return result;
 }
 
-std::shared_ptr<EventLog> EventLog::filter_by_timeframe(
+LogView LogView::filter_by_activity(const std::string& activity) const {
+    return filter_events([&activity](const Event& event) {
+        return event.activity == activity;
+    });
+}
+
+LogView LogView::filter_by_timeframe(
     const std::chrono::system_clock::time_point& start,
     const std::chrono::system_clock::time_point& end) const {
-    
-    auto filtered_log = std::make_shared<EventLog>();
-    
-    for (const auto& trace : traces_) {
-        Trace filtered_trace(trace.get_case_id());
-        bool has_events = false;
-        
-        for (const auto& event : trace.get_events()) {
-            if (event.timestamp >= start && event.timestamp <= end) {
-                has_events = true;
-                filtered_trace.add_event(event);
+    auto in_range = [&start, &end](const Event& event) {
+        return event.timestamp >= start && event.timestamp <= end;
+    };
+
+    const TimeIndex* index = log_->get_time_index();
+    if (!index) {
+        return filter_events(in_range);
+    }
+
+    if (full_) {
+        auto entries = index->range(start, end);
+        entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                     [this](const TimeIndex::Entry& e) { return e.trace >= size(); }),
+                      entries.end());
+        std::sort(entries.begin(), entries.end(), [](const TimeIndex::Entry& a, const TimeIndex::Entry& b) {
+            return a.trace != b.trace ? a.trace < b.trace : a.event < b.event;
+        });
+
+        LogView result(log_);
+        for (size_t i = 0; i < entries.size();) {
+            uint32_t trace = entries[i].trace;
+            std::vector<uint32_t> selection;
+            for (; i < entries.size() && entries[i].trace == trace; ++i) {
+                selection.push_back(entries[i].event);
+            }
+            result.trace_indexes_.push_back(trace);
+            if (selection.size() == log_->get_traces()[trace].get_events().size()) {
+                result.selections_.push_back(nullptr);
+            } else {
+                result.selections_.push_back(std::make_shared<const std::vector<uint32_t>>(std::move(selection)));
             }
         }
-        
-        if (has_events) {
-            filtered_log->add_trace(filtered_trace);
+        return result;
+    }
+
+    LogView result(log_);
+    const auto& bounds = index->get_bounds();
+    for (size_t i = 0; i < size(); ++i) {
+        size_t log_index = trace_index(i);
+        if (!index->overlaps(log_index, start, end)) {
+            continue;
+        }
+        if (bounds[log_index].first >= start && bounds[log_index].last <= end) {
+            result.trace_indexes_.push_back(log_index);
+            result.selections_.push_back(get_selection(i));
+            continue;
+        }
+
+        TraceView trace = get_trace(i);
+        std::vector<uint32_t> selection;
+        for (size_t j = 0; j < trace.size(); ++j) {
+            if (in_range(trace[j])) {
+                selection.push_back(static_cast<uint32_t>(trace.event_index(j)));
+            }
+        }
+        if (!selection.empty()) {
+            result.trace_indexes_.push_back(log_index);
+            result.selections_.push_back(std::make_shared<const std::vector<uint32_t>>(std::move(selection)));
         }
     }
+    return result;
+}
+
+std::shared_ptr<EventLog> LogView::materialize() const {
+    auto log = std::make_shared<EventLog>();
+    log->set_attribute_schema(log_->get_attribute_schema());
+    
+    for (const auto& view : *this) {
+        Trace trace(view.get_case_id());
+        for (const auto& attr : view.get_trace().get_attributes()) {
+            trace.set_attribute(attr.first, attr.second);
+        }
+        for (const auto& event : view) {
+            trace.add_event(event);
+        }
+        log->add_trace(std::move(trace));
+    }
     
-    return filtered_log;
+    return log;
+}
+
+LogView LogView::from_selection(const EventLog& log, std::vector<size_t> trace_indexes,
+                                std::vector<std::shared_ptr<const std::vector<uint32_t>>> selections) {
+    if (!selections.empty() && selections.size() != trace_indexes.size()) {
+        throw std::invalid_argument("Selection count does not match trace count");
+    }
+
+    LogView result(&log);
+    result.trace_indexes_ = std::move(trace_indexes);
+    result.selections_ = std::move(selections);
+    result.selections_.resize(result.trace_indexes_.size());
+    return result;
 }
 
 }
@@ -0,0 +1,193 @@
+#include "procmine/sampling.h"
+#include "procmine/sketch.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace procmine {
+
+namespace {
+
+void check_fraction(double fraction) {
+    if (!(fraction > 0.0 && fraction <= 1.0)) {
+        throw std::runtime_error("Sampling fraction must be in (0, 1]");
+    }
+}
+
+LogView select_positions(const LogView& view, const std::vector<size_t>& positions) {
+    std::vector<size_t> trace_indexes;
+    std::vector<std::shared_ptr<const std::vector<uint32_t>>> selections;
+    trace_indexes.reserve(positions.size());
+    selections.reserve(positions.size());
+    for (size_t position : positions) {
+        trace_indexes.push_back(view.trace_index(position));
+        selections.push_back(view.get_selection(position));
+    }
+    return LogView::from_selection(view.get_log(), std::move(trace_indexes), std::move(selections));
+}
+
+}
+
+bool sample_case(const std::string& case_id, double fraction, uint64_t seed) {
+    if (fraction >= 1.0) {
+        return true;
+    }
+    if (fraction <= 0.0) {
+        return false;
+    }
+    return sketch_hash(case_id, seed) < static_cast<uint64_t>(fraction * 18446744073709551616.0);
+}
+
+TraceSampler::TraceSampler(uint64_t seed) : seed_(seed) {}
+
+LogView TraceSampler::reservoir(const LogView& view, size_t sample_size) const {
+    std::mt19937_64 random(seed_);
+    std::vector<size_t> positions;
+    positions.reserve(std::min(sample_size, view.size()));
+
+    for (size_t i = 0; i < view.size(); ++i) {
+        if (positions.size() < sample_size) {
+            positions.push_back(i);
+            continue;
+        }
+        size_t slot = std::uniform_int_distribution<size_t>(0, i)(random);
+        if (slot < sample_size) {
+            positions[slot] = i;
+        }
+    }
+
+    std::sort(positions.begin(), positions.end());
+    return select_positions(view, positions);
+}
+
+LogView TraceSampler::stratified(const LogView& view, double fraction) const {
+    check_fraction(fraction);
+
+    std::unordered_map<uint64_t, std::vector<size_t>> strata;
+    std::vector<uint64_t> order;
+    for (size_t i = 0; i < view.size(); ++i) {
+        uint64_t hash = sketch_hash("");
+        for (const auto& event : view.get_trace(i)) {
+            hash = sketch_hash(event.activity, hash);
+        }
+        auto& members = strata[hash];
+        if (members.empty()) {
+            order.push_back(hash);
+        }
+        members.push_back(i);
+    }
+
+    std::mt19937_64 random(seed_);
+    std::vector<size_t> positions;
+    for (uint64_t hash : order) {
+        auto& members = strata[hash];
+        size_t take = std::max<size_t>(1, static_cast<size_t>(std::llround(fraction * members.size())));
+        for (size_t i = 0; i < take; ++i) {
+            size_t pick = std::uniform_int_distribution<size_t>(i, members.size() - 1)(random);
+            std::swap(members[i], members[pick]);
+            positions.push_back(members[i]);
+        }
+    }
+
+    std::sort(positions.begin(), positions.end());
+    return select_positions(view, positions);
+}
+
+LogView TraceSampler::hash_by_case(const LogView& view, double fraction) const {
+    check_fraction(fraction);
+    std::vector<size_t> positions;
+    for (size_t i = 0; i < view.size(); ++i) {
+        if (sample_case(view.get_trace(i).get_case_id(), fraction, seed_)) {
+            positions.push_back(i);
+        }
+    }
+    return select_positions(view, positions);
+}
+
+std::vector<EdgeFrequencyEstimate> TraceSampler::estimate_edge_frequencies(
+    const LogView& sample, size_t population_traces) const {
+
+    struct Moments {
+        uint64_t sum = 0;
+        double sum_squares = 0.0;
+    };
+
+    const double n = static_cast<double>(sample.size());
+    const double population = static_cast<double>(std::max(population_traces, sample.size()));
+
+    std::unordered_map<std::string, std::unordered_map<std::string, Moments>> moments;
+    std::unordered_map<std::string, std::unordered_map<std::string, uint64_t>> per_trace;
+    for (const auto& trace : sample) {
+        per_trace.clear();
+        for (size_t i = 0; i + 1 < trace.size(); ++i) {
+            per_trace[trace[i].activity][trace[i + 1].activity]++;
+        }
+        for (const auto& [from, targets] : per_trace) {
+            for (const auto& [to, count] : targets) {
+                Moments& edge = moments[from][to];
+                edge.sum += count;
+                edge.sum_squares += static_cast<double>(count) * static_cast<double>(count);
+            }
+        }
+    }
+
+    std::vector<EdgeFrequencyEstimate> estimates;
+    for (const auto& [from, targets] : moments) {
+        for (const auto& [to, edge] : targets) {
+            double mean = static_cast<double>(edge.sum) / n;
+            double variance = n > 1.0 ? (edge.sum_squares - n * mean * mean) / (n - 1.0) : 0.0;
+            double correction = 1.0 - n / population;
+            double error = population * std::sqrt(std::max(0.0, variance / n * correction));
+            estimates.push_back({from, to, edge.sum, population * mean, error});
+        }
+    }
+
+    std::sort(estimates.begin(), estimates.end(), [](const auto& a, const auto& b) {
+        if (a.sample_count != b.sample_count) {
+            return a.sample_count > b.sample_count;
+        }
+        return a.from != b.from ? a.from < b.from : a.to < b.to;
+    });
+    return estimates;
+}
+
+void TraceSampler::set_seed(uint64_t seed) {
+    seed_ = seed;
+}
+
+TraceReservoir::TraceReservoir(size_t capacity, uint64_t seed)
+    : capacity_(capacity), seen_(0), random_(seed) {
+    traces_.reserve(capacity_);
+}
+
+void TraceReservoir::add(const Trace& trace, const AttributeSchema* schema) {
+    seen_++;
+    Trace* kept = nullptr;
+    if (traces_.size() < capacity_) {
+        kept = &traces_.emplace_back(trace);
+    } else {
+        uint64_t slot = std::uniform_int_distribution<uint64_t>(0, seen_ - 1)(random_);
+        if (slot < capacity_) {
+            traces_[slot] = trace;
+            kept = &traces_[slot];
+        }
+    }
+    if (kept && schema) {
+        kept->expand_attributes(*schema);
+    }
+}
+
+uint64_t TraceReservoir::seen() const {
+    return seen_;
+}
+
+std::shared_ptr<EventLog> TraceReservoir::to_log() const {
+    auto log = std::make_shared<EventLog>();
+    for (const auto& trace : traces_) {
+        log->add_trace(trace);
+    }
+    return log;
+}
+
+}
@@ -0,0 +1,469 @@
+#include "procmine/sketch.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace procmine {
+
+namespace {
+
+uint64_t mix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+}
+
+uint64_t sketch_hash(std::string_view data, uint64_t seed) {
+    uint64_t hash = 1469598103934665603ULL ^ mix(seed);
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return mix(hash);
+}
+
+TDigest::TDigest(double compression)
+    : compression_(compression), total_weight_(0.0), sum_(0.0),
+      min_(std::numeric_limits<double>::infinity()),
+      max_(-std::numeric_limits<double>::infinity()) {
+    if (!(compression >= 10.0)) {
+        throw std::runtime_error("t-digest compression must be at least 10");
+    }
+}
+
+void TDigest::add(double value, double weight) {
+    if (std::isnan(value) || !(weight > 0.0)) {
+        return;
+    }
+    if (buffer_.capacity() == 0) {
+        buffer_.reserve(static_cast<size_t>(compression_) * 4);
+    }
+    buffer_.push_back({value, weight});
+    total_weight_ += weight;
+    sum_ += value * weight;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+    if (buffer_.size() >= static_cast<size_t>(compression_) * 4) {
+        compress();
+    }
+}
+
+void TDigest::merge(const TDigest& other) {
+    if (other.empty()) {
+        return;
+    }
+    buffer_.insert(buffer_.end(), other.centroids_.begin(), other.centroids_.end());
+    buffer_.insert(buffer_.end(), other.buffer_.begin(), other.buffer_.end());
+    total_weight_ += other.total_weight_;
+    sum_ += other.sum_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    compress();
+}
+
+void TDigest::flush_buffer() const {
+    buffer_.insert(buffer_.end(), centroids_.begin(), centroids_.end());
+    std::sort(buffer_.begin(), buffer_.end(),
+              [](const Centroid& a, const Centroid& b) { return a.mean < b.mean; });
+    centroids_.clear();
+}
+
+void TDigest::compress() const {
+    if (buffer_.empty()) {
+        return;
+    }
+    flush_buffer();
+
+    const double normalizer = 4.0 * total_weight_ / compression_;
+    double processed = 0.0;
+    Centroid current = buffer_.front();
+
+    for (size_t i = 1; i < buffer_.size(); ++i) {
+        const Centroid& next = buffer_[i];
+        double proposed = current.weight + next.weight;
+        double q = (processed + proposed / 2.0) / total_weight_;
+        if (proposed <= normalizer * q * (1.0 - q)) {
+            current.mean += (next.mean - current.mean) * next.weight / proposed;
+            current.weight = proposed;
+        } else {
+            processed += current.weight;
+            centroids_.push_back(current);
+            current = next;
+        }
+    }
+    centroids_.push_back(current);
+    buffer_.clear();
+}
+
+double TDigest::quantile(double q) const {
+    if (q < 0.0 || q > 1.0) {
+        throw std::runtime_error("Quantile must be between 0 and 1");
+    }
+    if (empty()) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    compress();
+    if (centroids_.size() == 1) {
+        return centroids_.front().mean;
+    }
+
+    const double index = q * total_weight_;
+    double cumulative = 0.0;
+    double previous_center = 0.0;
+    double previous_mean = min_;
+
+    for (const auto& centroid : centroids_) {
+        double center = cumulative + centroid.weight / 2.0;
+        if (index < center) {
+            double span = center - previous_center;
+            double fraction = span > 0.0 ? (index - previous_center) / span : 0.0;
+            return previous_mean + fraction * (centroid.mean - previous_mean);
+        }
+        cumulative += centroid.weight;
+        previous_center = center;
+        previous_mean = centroid.mean;
+    }
+
+    double span = total_weight_ - previous_center;
+    double fraction = span > 0.0 ? (index - previous_center) / span : 1.0;
+    return previous_mean + fraction * (max_ - previous_mean);
+}
+
+double TDigest::count() const {
+    return total_weight_;
+}
+
+double TDigest::min() const {
+    return empty() ? std::numeric_limits<double>::quiet_NaN() : min_;
+}
+
+double TDigest::max() const {
+    return empty() ? std::numeric_limits<double>::quiet_NaN() : max_;
+}
+
+double TDigest::mean() const {
+    return empty() ? std::numeric_limits<double>::quiet_NaN() : sum_ / total_weight_;
+}
+
+bool TDigest::empty() const {
+    return total_weight_ == 0.0;
+}
+
+double TDigest::get_compression() const {
+    return compression_;
+}
+
+size_t TDigest::centroid_count() const {
+    return centroids_.size() + buffer_.size();
+}
+
+size_t TDigest::memory_usage() const {
+    return sizeof(*this) + (centroids_.capacity() + buffer_.capacity()) * sizeof(Centroid);
+}
+
+CountMinSketch::CountMinSketch(size_t width, size_t depth, uint64_t seed)
+    : width_(width), depth_(depth), seed_(seed), conservative_(true), total_(0) {
+    if (width == 0 || depth == 0) {
+        throw std::runtime_error("Count-min sketch dimensions must be positive");
+    }
+    counters_.assign(width_ * depth_, 0);
+}
+
+CountMinSketch CountMinSketch::with_error(double epsilon, double delta, uint64_t seed) {
+    if (!(epsilon > 0.0 && epsilon < 1.0) || !(delta > 0.0 && delta < 1.0)) {
+        throw std::runtime_error("Count-min sketch error bounds must be between 0 and 1");
+    }
+    size_t width = static_cast<size_t>(std::ceil(std::exp(1.0) / epsilon));
+    size_t depth = static_cast<size_t>(std::ceil(std::log(1.0 / delta)));
+    return CountMinSketch(width, std::max<size_t>(1, depth), seed);
+}
+
+void CountMinSketch::set_conservative_update(bool enabled) {
+    conservative_ = enabled;
+}
+
+size_t CountMinSketch::column(uint64_t key, size_t row) const {
+    uint64_t hash = mix(key ^ seed_);
+    uint64_t step = mix(hash) | 1;
+    return static_cast<size_t>((hash + row * step) % width_);
+}
+
+uint64_t CountMinSketch::add(uint64_t key, uint64_t count) {
+    total_ += count;
+
+    if (!conservative_) {
+        uint64_t minimum = UINT64_MAX;
+        for (size_t row = 0; row < depth_; ++row) {
+            uint64_t& counter = counters_[row * width_ + column(key, row)];
+            counter += count;
+            minimum = std::min(minimum, counter);
+        }
+        return minimum;
+    }
+
+    uint64_t target = estimate(key) + count;
+    for (size_t row = 0; row < depth_; ++row) {
+        uint64_t& counter = counters_[row * width_ + column(key, row)];
+        counter = std::max(counter, target);
+    }
+    return target;
+}
+
+uint64_t CountMinSketch::estimate(uint64_t key) const {
+    uint64_t minimum = UINT64_MAX;
+    for (size_t row = 0; row < depth_; ++row) {
+        minimum = std::min(minimum, counters_[row * width_ + column(key, row)]);
+    }
+    return minimum;
+}
+
+void CountMinSketch::merge(const CountMinSketch& other) {
+    if (width_ != other.width_ || depth_ != other.depth_ || seed_ != other.seed_) {
+        throw std::runtime_error("Cannot merge count-min sketches with different parameters");
+    }
+    for (size_t i = 0; i < counters_.size(); ++i) {
+        counters_[i] += other.counters_[i];
+    }
+    total_ += other.total_;
+}
+
+uint64_t CountMinSketch::total() const {
+    return total_;
+}
+
+size_t CountMinSketch::width() const {
+    return width_;
+}
+
+size_t CountMinSketch::depth() const {
+    return depth_;
+}
+
+double CountMinSketch::error_bound() const {
+    return std::exp(1.0) / static_cast<double>(width_) * static_cast<double>(total_);
+}
+
+size_t CountMinSketch::memory_usage() const {
+    return sizeof(*this) + counters_.capacity() * sizeof(uint64_t);
+}
+
+HyperLogLog::HyperLogLog(unsigned precision) : precision_(precision) {
+    if (precision < 4 || precision > 18) {
+        throw std::runtime_error("HyperLogLog precision must be between 4 and 18");
+    }
+    registers_.assign(size_t(1) << precision_, 0);
+}
+
+void HyperLogLog::add(std::string_view value) {
+    add_hash(sketch_hash(value));
+}
+
+void HyperLogLog::add_hash(uint64_t hash) {
+    size_t index = static_cast<size_t>(hash >> (64 - precision_));
+    uint64_t rest = hash << precision_;
+    uint8_t rank = rest == 0 ? static_cast<uint8_t>(64 - precision_ + 1)
+                             : static_cast<uint8_t>(__builtin_clzll(rest) + 1);
+    registers_[index] = std::max(registers_[index], rank);
+}
+
+void HyperLogLog::merge(const HyperLogLog& other) {
+    if (precision_ != other.precision_) {
+        throw std::runtime_error("Cannot merge HyperLogLog sketches with different precision");
+    }
+    for (size_t i = 0; i < registers_.size(); ++i) {
+        registers_[i] = std::max(registers_[i], other.registers_[i]);
+    }
+}
+
+double HyperLogLog::estimate() const {
+    const double m = static_cast<double>(registers_.size());
+    double alpha;
+    switch (registers_.size()) {
+        case 16: alpha = 0.673; break;
+        case 32: alpha = 0.697; break;
+        case 64: alpha = 0.709; break;
+        default: alpha = 0.7213 / (1.0 + 1.079 / m); break;
+    }
+
+    double sum = 0.0;
+    size_t zeros = 0;
+    for (uint8_t value : registers_) {
+        sum += std::ldexp(1.0, -static_cast<int>(value));
+        if (value == 0) {
+            zeros++;
+        }
+    }
+
+    double estimate = alpha * m * m / sum;
+    if (estimate <= 2.5 * m && zeros > 0) {
+        return m * std::log(m / static_cast<double>(zeros));
+    }
+    return estimate;
+}
+
+unsigned HyperLogLog::get_precision() const {
+    return precision_;
+}
+
+size_t HyperLogLog::memory_usage() const {
+    return sizeof(*this) + registers_.capacity();
+}
+
+SpaceSaving::SpaceSaving(size_t capacity) : capacity_(capacity), total_(0) {
+    if (capacity == 0) {
+        throw std::runtime_error("Space-Saving capacity must be positive");
+    }
+    heap_.reserve(capacity_);
+    positions_.reserve(capacity_);
+}
+
+void SpaceSaving::swap_entries(size_t a, size_t b) {
+    std::swap(heap_[a], heap_[b]);
+    positions_[heap_[a].key] = a;
+    positions_[heap_[b].key] = b;
+}
+
+void SpaceSaving::sift_down(size_t index) {
+    for (;;) {
+        size_t smallest = index;
+        size_t left = 2 * index + 1;
+        size_t right = left + 1;
+        if (left < heap_.size() && heap_[left].count < heap_[smallest].count) {
+            smallest = left;
+        }
+        if (right < heap_.size() && heap_[right].count < heap_[smallest].count) {
+            smallest = right;
+        }
+        if (smallest == index) {
+            return;
+        }
+        swap_entries(index, smallest);
+        index = smallest;
+    }
+}
+
+std::optional<uint64_t> SpaceSaving::add(uint64_t key, uint64_t count) {
+    total_ += count;
+
+    auto it = positions_.find(key);
+    if (it != positions_.end()) {
+        heap_[it->second].count += count;
+        sift_down(it->second);
+        return std::nullopt;
+    }
+
+    if (heap_.size() < capacity_) {
+        heap_.push_back({key, count, 0});
+        size_t index = heap_.size() - 1;
+        positions_[key] = index;
+        while (index > 0) {
+            size_t parent = (index - 1) / 2;
+            if (heap_[parent].count <= heap_[index].count) {
+                break;
+            }
+            swap_entries(index, parent);
+            index = parent;
+        }
+        return std::nullopt;
+    }
+
+    Counter& minimum = heap_.front();
+    uint64_t evicted = minimum.key;
+    positions_.erase(evicted);
+    minimum.key = key;
+    minimum.error = minimum.count;
+    minimum.count += count;
+    positions_[key] = 0;
+    sift_down(0);
+    return evicted;
+}
+
+void SpaceSaving::merge(const SpaceSaving& other) {
+    const uint64_t own_floor = heap_.size() < capacity_ ? 0 : min_count();
+    const uint64_t other_floor = other.heap_.size() < other.capacity_ ? 0 : other.min_count();
+
+    std::unordered_map<uint64_t, Counter> combined;
+    for (const auto& counter : heap_) {
+        combined[counter.key] = {counter.key, counter.count + other_floor, counter.error + other_floor};
+    }
+    for (const auto& counter : other.heap_) {
+        auto it = combined.find(counter.key);
+        if (it == combined.end()) {
+            combined[counter.key] = {counter.key, counter.count + own_floor, counter.error + own_floor};
+        } else {
+            it->second.count += counter.count - other_floor;
+            it->second.error += counter.error - other_floor;
+        }
+    }
+
+    std::vector<Counter> counters;
+    counters.reserve(combined.size());
+    for (const auto& entry : combined) {
+        counters.push_back(entry.second);
+    }
+    std::sort(counters.begin(), counters.end(), [](const Counter& a, const Counter& b) {
+        return a.count != b.count ? a.count > b.count : a.key < b.key;
+    });
+    if (counters.size() > capacity_) {
+        counters.resize(capacity_);
+    }
+
+    std::reverse(counters.begin(), counters.end());
+    heap_ = std::move(counters);
+    positions_.clear();
+    for (size_t i = 0; i < heap_.size(); ++i) {
+        positions_[heap_[i].key] = i;
+    }
+    total_ += other.total_;
+}
+
+bool SpaceSaving::contains(uint64_t key) const {
+    return positions_.count(key) > 0;
+}
+
+uint64_t SpaceSaving::estimate(uint64_t key) const {
+    auto it = positions_.find(key);
+    if (it != positions_.end()) {
+        return heap_[it->second].count;
+    }
+    return heap_.size() < capacity_ ? 0 : min_count();
+}
+
+std::vector<SpaceSaving::Counter> SpaceSaving::top(size_t k) const {
+    std::vector<Counter> result = heap_;
+    std::sort(result.begin(), result.end(), [](const Counter& a, const Counter& b) {
+        return a.count != b.count ? a.count > b.count : a.key < b.key;
+    });
+    if (result.size() > k) {
+        result.resize(k);
+    }
+    return result;
+}
+
+uint64_t SpaceSaving::total() const {
+    return total_;
+}
+
+uint64_t SpaceSaving::min_count() const {
+    return heap_.empty() ? 0 : heap_.front().count;
+}
+
+size_t SpaceSaving::size() const {
+    return heap_.size();
+}
+
+size_t SpaceSaving::get_capacity() const {
+    return capacity_;
+}
+
+size_t SpaceSaving::memory_usage() const {
+    return sizeof(*this) + heap_.capacity() * sizeof(Counter) +
+           positions_.size() * (sizeof(std::pair<uint64_t, size_t>) + sizeof(void*)) +
+           positions_.bucket_count() * sizeof(void*);
+}
+
+}
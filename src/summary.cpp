@@ -0,0 +1,281 @@
+#include "procmine/summary.h"
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace procmine {
+
+namespace {
+
+constexpr char summary_magic[4] = {'P', 'M', 'S', '1'};
+
+void put_varint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+class SummaryDecoder {
+public:
+    explicit SummaryDecoder(std::string_view data) : data_(data), position_(0) {}
+
+    uint64_t varint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (position_ >= data_.size()) {
+                throw std::runtime_error("Unexpected end of mining summary");
+            }
+            uint8_t byte = static_cast<uint8_t>(data_[position_++]);
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        throw std::runtime_error("Malformed varint in mining summary");
+    }
+
+    uint64_t count(size_t min_entry_size) {
+        uint64_t value = varint();
+        if (value > (data_.size() - position_) / min_entry_size) {
+            throw std::runtime_error("Mining summary entry count exceeds remaining data");
+        }
+        return value;
+    }
+
+    std::string_view bytes(size_t size) {
+        if (size > data_.size() - position_) {
+            throw std::runtime_error("Unexpected end of mining summary");
+        }
+        std::string_view result = data_.substr(position_, size);
+        position_ += size;
+        return result;
+    }
+
+    bool done() const { return position_ == data_.size(); }
+
+private:
+    std::string_view data_;
+    size_t position_;
+};
+
+void merge_counts(std::map<std::string, uint64_t>& into, const std::map<std::string, uint64_t>& from) {
+    for (const auto& [key, count] : from) {
+        into[key] += count;
+    }
+}
+
+}
+
+MiningSummary::MiningSummary() : traces_(0) {}
+
+MiningSummary::MiningSummary(const LogView& view) : traces_(0) {
+    for (const auto& trace : view) {
+        add_trace(trace);
+    }
+}
+
+template <typename Events>
+void MiningSummary::add_events(const Events& events) {
+    traces_++;
+
+    std::vector<std::string> variant;
+    variant.reserve(events.size());
+    for (const auto& event : events) {
+        activities_[event.activity]++;
+        variant.push_back(event.activity);
+    }
+    if (!variant.empty()) {
+        starts_[variant.front()]++;
+        ends_[variant.back()]++;
+    }
+    for (size_t i = 0; i + 1 < variant.size(); ++i) {
+        transitions_[{variant[i], variant[i + 1]}]++;
+    }
+    variants_[std::move(variant)]++;
+}
+
+void MiningSummary::add_trace(const Trace& trace) {
+    add_events(trace.get_events());
+}
+
+void MiningSummary::add_trace(const TraceView& trace) {
+    add_events(trace);
+}
+
+void MiningSummary::merge(const MiningSummary& other) {
+    traces_ += other.traces_;
+    merge_counts(activities_, other.activities_);
+    merge_counts(starts_, other.starts_);
+    merge_counts(ends_, other.ends_);
+    for (const auto& [edge, count] : other.transitions_) {
+        transitions_[edge] += count;
+    }
+    for (const auto& [variant, count] : other.variants_) {
+        variants_[variant] += count;
+    }
+}
+
+uint64_t MiningSummary::trace_count() const {
+    return traces_;
+}
+
+const std::map<std::string, uint64_t>& MiningSummary::get_activity_counts() const {
+    return activities_;
+}
+
+const std::map<std::string, uint64_t>& MiningSummary::get_start_counts() const {
+    return starts_;
+}
+
+const std::map<std::string, uint64_t>& MiningSummary::get_end_counts() const {
+    return ends_;
+}
+
+const std::map<std::pair<std::string, std::string>, uint64_t>& MiningSummary::get_transition_counts() const {
+    return transitions_;
+}
+
+const std::map<std::vector<std::string>, uint64_t>& MiningSummary::get_variant_counts() const {
+    return variants_;
+}
+
+std::string MiningSummary::serialize() const {
+    std::unordered_map<std::string_view, uint64_t> ids;
+    std::string out(summary_magic, sizeof(summary_magic));
+
+    put_varint(out, traces_);
+    put_varint(out, activities_.size());
+    for (const auto& [activity, count] : activities_) {
+        ids.emplace(activity, ids.size());
+        put_varint(out, activity.size());
+        out.append(activity);
+        put_varint(out, count);
+    }
+
+    for (const auto* counts : {&starts_, &ends_}) {
+        put_varint(out, counts->size());
+        for (const auto& [activity, count] : *counts) {
+            put_varint(out, ids.at(activity));
+            put_varint(out, count);
+        }
+    }
+
+    put_varint(out, transitions_.size());
+    for (const auto& [edge, count] : transitions_) {
+        put_varint(out, ids.at(edge.first));
+        put_varint(out, ids.at(edge.second));
+        put_varint(out, count);
+    }
+
+    put_varint(out, variants_.size());
+    for (const auto& [variant, count] : variants_) {
+        put_varint(out, variant.size());
+        for (const auto& activity : variant) {
+            put_varint(out, ids.at(activity));
+        }
+        put_varint(out, count);
+    }
+
+    return out;
+}
+
+MiningSummary MiningSummary::deserialize(std::string_view data) {
+    SummaryDecoder decoder(data);
+    if (decoder.bytes(sizeof(summary_magic)) != std::string_view(summary_magic, sizeof(summary_magic))) {
+        throw std::runtime_error("Not a mining summary");
+    }
+
+    MiningSummary summary;
+    std::vector<std::string> names;
+
+    auto name = [&names](uint64_t id) -> const std::string& {
+        if (id >= names.size()) {
+            throw std::runtime_error("Mining summary references unknown activity");
+        }
+        return names[id];
+    };
+
+    summary.traces_ = decoder.varint();
+    uint64_t activities = decoder.count(2);
+    for (uint64_t i = 0; i < activities; ++i) {
+        names.emplace_back(decoder.bytes(decoder.varint()));
+        summary.activities_.emplace_hint(summary.activities_.end(), names.back(), decoder.varint());
+    }
+
+    for (auto* counts : {&summary.starts_, &summary.ends_}) {
+        uint64_t entries = decoder.count(2);
+        for (uint64_t i = 0; i < entries; ++i) {
+            const std::string& activity = name(decoder.varint());
+            (*counts)[activity] = decoder.varint();
+        }
+    }
+
+    uint64_t transitions = decoder.count(3);
+    for (uint64_t i = 0; i < transitions; ++i) {
+        const std::string& from = name(decoder.varint());
+        const std::string& to = name(decoder.varint());
+        summary.transitions_[{from, to}] = decoder.varint();
+    }
+
+    uint64_t variants = decoder.count(2);
+    for (uint64_t i = 0; i < variants; ++i) {
+        std::vector<std::string> variant(decoder.count(1));
+        for (auto& activity : variant) {
+            activity = name(decoder.varint());
+        }
+        summary.variants_[std::move(variant)] = decoder.varint();
+    }
+
+    if (!decoder.done()) {
+        throw std::runtime_error("Trailing data after mining summary");
+    }
+    return summary;
+}
+
+void MiningSummary::write(std::ostream& out) const {
+    std::string data = serialize();
+    std::string header;
+    put_varint(header, data.size());
+    out.write(header.data(), static_cast<std::streamsize>(header.size()));
+    out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    if (!out) {
+        throw std::runtime_error("Failed to write mining summary");
+    }
+}
+
+MiningSummary MiningSummary::read(std::istream& in) {
+    uint64_t size = 0;
+    for (int shift = 0;; shift += 7) {
+        int byte = in.get();
+        if (byte == std::char_traits<char>::eof() || shift >= 64) {
+            throw std::runtime_error("Failed to read mining summary");
+        }
+        size |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            break;
+        }
+    }
+
+    constexpr uint64_t chunk_size = 64 * 1024;
+    std::string data;
+    while (data.size() < size) {
+        size_t offset = data.size();
+        size_t chunk = static_cast<size_t>(std::min(chunk_size, size - offset));
+        data.resize(offset + chunk);
+        in.read(data.data() + offset, static_cast<std::streamsize>(chunk));
+        if (static_cast<size_t>(in.gcount()) != chunk) {
+            throw std::runtime_error("Unexpected end of mining summary");
+        }
+    }
+    return deserialize(data);
+}
+
+bool MiningSummary::operator==(const MiningSummary& other) const {
+    return traces_ == other.traces_ && activities_ == other.activities_ &&
+           starts_ == other.starts_ && ends_ == other.ends_ &&
+           transitions_ == other.transitions_ && variants_ == other.variants_;
+}
+
+}
@@ -1,7 +1,9 @@
 #include <gtest/gtest.h>
 #include "procmine/algorithm.h"
 #include "procmine/models.h"
+#include "test_logs.h"
 #include <chrono>
+#include <thread>
 
 namespace {
     using namespace procmine;
@@ -102,4 +104,300 @@ TEST(AlgorithmTest, HeuristicMiner) {
 
     std::string dot = process_graph->to_dot();
     EXPECT_FALSE(dot.empty());
-} 
\ No newline at end of file
+}
+
+TEST(AlgorithmTest, MiningOverLogView) {
+    EventLog log = create_test_log();
+
+    LogView view = LogView(log).filter_traces([](const TraceView& trace) {
+        return trace.get_case_id() == "case1";
+    });
+
+    AlphaAlgorithm alpha;
+    auto process_graph = alpha.mine(view);
+
+    auto edges_from_a = process_graph->get_outgoing_edges("A");
+    ASSERT_EQ(edges_from_a.size(), 1);
+    EXPECT_EQ(edges_from_a[0].to, "B");
+
+    ConformanceChecker checker(*process_graph);
+    EXPECT_DOUBLE_EQ(checker.calculate_overall_conformance(view), 1.0);
+    EXPECT_LT(checker.calculate_overall_conformance(log), 1.0);
+}
+
+TEST(AlgorithmTest, FrozenProcessGraph) {
+    ProcessGraph graph;
+    for (int i = 0; i < 500; ++i) {
+        graph.add_edge("activity" + std::to_string(i), "activity" + std::to_string((i * 7 + 3) % 500), i + 1.0);
+        graph.add_edge("activity" + std::to_string(i), "activity" + std::to_string((i + 1) % 500), 0.5);
+    }
+
+    auto frozen = graph.freeze();
+    EXPECT_EQ(frozen->node_count(), 500);
+    EXPECT_EQ(frozen->edge_count(), 1000);
+    EXPECT_EQ(frozen->find_node("missing"), FrozenProcessGraph::npos);
+
+    std::vector<std::thread> readers;
+    std::vector<int> mismatches(4, 0);
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&, t] {
+            for (int i = 0; i < 500; ++i) {
+                std::string name = "activity" + std::to_string(i);
+                uint32_t node = frozen->find_node(name);
+                if (node == FrozenProcessGraph::npos || frozen->get_name(node) != name) {
+                    mismatches[t]++;
+                    continue;
+                }
+                double weight = 0.0;
+                uint32_t target = frozen->find_node("activity" + std::to_string((i * 7 + 3) % 500));
+                if (!frozen->find_edge(node, target, weight) || weight != i + 1.0) {
+                    mismatches[t]++;
+                }
+            }
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(mismatches, std::vector<int>(4, 0));
+
+    auto edges = frozen->get_outgoing_edges("activity1");
+    EXPECT_EQ(edges.size(), 2);
+    EXPECT_EQ(graph.get_outgoing_edges("activity1").size(), 2);
+
+    EventLog log = create_test_log();
+    auto model = HeuristicMiner(0.0, 0.0).mine(log);
+    auto frozen_model = model->freeze();
+    ConformanceChecker checker(*model);
+    ConformanceChecker frozen_checker(*frozen_model);
+    for (const auto& trace : log.get_traces()) {
+        auto expected = checker.check_trace(trace);
+        auto actual = frozen_checker.check_trace(trace);
+        EXPECT_EQ(actual.matched_activities, expected.matched_activities);
+        EXPECT_EQ(actual.violations, expected.violations);
+    }
+}
+
+TEST(AlgorithmTest, ProcessGraphAccessors) {
+    ProcessGraph graph;
+    graph.add_edge("A", "B", 2.0);
+    graph.add_edge("A", "C", 3.0);
+    graph.add_edge("B", "C", 1.0);
+
+    EXPECT_EQ(graph.node_count(), 3);
+    Vertex a = graph.find_node(std::string_view("A"));
+    Vertex c = graph.find_node(std::string_view("C"));
+    ASSERT_NE(a, ProcessGraph::npos);
+    EXPECT_EQ(graph.get_name(a), "A");
+    EXPECT_EQ(graph.find_node(std::string_view("missing")), ProcessGraph::npos);
+
+    double total = 0.0;
+    size_t count = 0;
+    for (const auto& edge : graph.out_edges(a)) {
+        EXPECT_EQ(edge.from, a);
+        total += edge.weight;
+        ++count;
+    }
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(graph.out_edges(a).size(), 2);
+    EXPECT_DOUBLE_EQ(total, 5.0);
+    EXPECT_TRUE(graph.out_edges(c).empty());
+
+    EXPECT_TRUE(graph.has_edge(a, c));
+    EXPECT_FALSE(graph.has_edge(c, a));
+    EXPECT_TRUE(graph.has_edge(std::string_view("B"), std::string_view("C")));
+    EXPECT_FALSE(graph.has_edge(std::string_view("B"), std::string_view("missing")));
+
+    double weight = 0.0;
+    ASSERT_TRUE(graph.find_edge(a, c, weight));
+    EXPECT_DOUBLE_EQ(weight, 3.0);
+    EXPECT_FALSE(graph.find_edge(c, a, weight));
+}
+
+TEST(AlgorithmTest, DFGSimplifier) {
+    ProcessGraph graph;
+    graph.add_edge("start", "A", 100);
+    graph.add_edge("A", "B", 90);
+    graph.add_edge("B", "end", 90);
+    graph.add_edge("A", "rare", 2);
+    graph.add_edge("rare", "end", 1);
+    graph.add_edge("A", "x1", 3);
+    graph.add_edge("x1", "x2", 3);
+    graph.add_edge("x2", "B", 3);
+
+    DFGSimplifier simplifier(graph);
+    auto full = simplifier.simplify();
+    EXPECT_EQ(full->node_count(), graph.node_count());
+
+    simplifier.set_edge_percentage(0.0);
+    auto minimal = simplifier.simplify();
+    EXPECT_TRUE(minimal->has_edge(std::string_view("start"), std::string_view("A")));
+    EXPECT_TRUE(minimal->has_edge(std::string_view("A"), std::string_view("B")));
+    EXPECT_TRUE(minimal->has_edge(std::string_view("B"), std::string_view("end")));
+    EXPECT_EQ(minimal->node_count(), 4);
+
+    simplifier.set_edge_percentage(0.4);
+    auto pruned = simplifier.simplify();
+    EXPECT_EQ(pruned->find_node(std::string_view("rare")), ProcessGraph::npos);
+
+    simplifier.set_edge_percentage(1.0);
+    simplifier.set_node_threshold(0.05);
+    auto clustered = simplifier.simplify();
+    EXPECT_EQ(clustered->find_node(std::string_view("x1")), ProcessGraph::npos);
+    EXPECT_NE(clustered->find_node(std::string_view("Cluster 1")), ProcessGraph::npos);
+    EXPECT_TRUE(clustered->has_edge(std::string_view("A"), std::string_view("Cluster 1")));
+    EXPECT_TRUE(clustered->has_edge(std::string_view("Cluster 1"), std::string_view("B")));
+    EXPECT_NE(clustered->find_node(std::string_view("rare")), ProcessGraph::npos);
+}
+
+TEST(AlgorithmTest, DFGSimplifierClusterNamesAvoidActivities) {
+    auto build = [] {
+        ProcessGraph graph;
+        graph.add_edge("start", "Cluster 1", 100);
+        graph.add_edge("Cluster 1", "end", 100);
+        graph.add_edge("Cluster 1", "x1", 3);
+        graph.add_edge("x1", "x2", 3);
+        graph.add_edge("x2", "end", 3);
+        return graph;
+    };
+
+    DFGSimplifier simplifier(build());
+    simplifier.set_node_threshold(0.05);
+    auto clustered = simplifier.simplify();
+    EXPECT_EQ(clustered->find_node(std::string_view("x1")), ProcessGraph::npos);
+    EXPECT_EQ(clustered->node_count(), 4);
+    EXPECT_TRUE(clustered->has_edge(std::string_view("start"), std::string_view("Cluster 1")));
+    EXPECT_TRUE(clustered->has_edge(std::string_view("Cluster 1"), std::string_view("Cluster 2")));
+    EXPECT_TRUE(clustered->has_edge(std::string_view("Cluster 2"), std::string_view("end")));
+    EXPECT_FALSE(clustered->has_edge(std::string_view("start"), std::string_view("Cluster 2")));
+}
+
+TEST(AlgorithmTest, InductiveMiner) {
+    EventLog log = test::build_log({{"A", "B", "C", "D"}, {"A", "C", "B", "D"}, {"A", "E", "D"}});
+    InductiveMiner miner;
+    EXPECT_EQ(miner.mine_tree(log)->to_string(), "->(A, X(+(B, C), E), D)");
+
+    miner.set_parallelism(4);
+    EXPECT_EQ(miner.mine_tree(log)->to_string(), "->(A, X(+(B, C), E), D)");
+
+    auto model = miner.mine(log);
+    ConformanceChecker checker(*model);
+    EXPECT_DOUBLE_EQ(checker.calculate_overall_conformance(log), 1.0);
+
+    EventLog loop_log = test::build_log({{"X", "Y"}, {"X", "Y", "Z", "X", "Y"}, {"X"}});
+    EXPECT_EQ(miner.mine_tree(loop_log)->to_string(), "*(->(X, X(tau, Y)), Z)");
+    EXPECT_EQ(InductiveMiner().mine_tree(LogView(loop_log))->to_string(), "*(->(X, X(tau, Y)), Z)");
+}
+
+TEST(AlgorithmTest, PerformanceAnalyzer) {
+    EventLog log = test::build_log(100, [](size_t) { return std::vector<std::string>{"A", "B", "C"}; },
+        [](size_t t, size_t index, Event& event) {
+            int offsets[] = {0, 10 + static_cast<int>(t % 10), 70 + static_cast<int>(t % 10)};
+            event.timestamp += seconds(offsets[index]) - seconds(index);
+        });
+
+    PerformanceAnalyzer analyzer;
+    analyzer.set_parallelism(4);
+    auto metrics = analyzer.analyze(log);
+
+    auto ab = PerformanceAnalyzer::summarize(metrics.transition_time.at("A").at("B"));
+    EXPECT_EQ(ab.count, 100);
+    EXPECT_DOUBLE_EQ(ab.min, 10.0);
+    EXPECT_DOUBLE_EQ(ab.max, 19.0);
+    EXPECT_DOUBLE_EQ(ab.mean, 14.5);
+    EXPECT_NEAR(ab.p50, 14.5, 1.0);
+    EXPECT_NEAR(ab.p99, 19.0, 0.5);
+    EXPECT_DOUBLE_EQ(PerformanceAnalyzer::summarize(metrics.sojourn_time.at("C")).p95, 60.0);
+    EXPECT_EQ(metrics.sojourn_time.count("A"), 0);
+
+    auto graph = analyzer.build_process_graph(metrics, 0.5);
+    double weight = 0.0;
+    ASSERT_TRUE(graph->find_edge(graph->find_node(std::string_view("B")),
+                                 graph->find_node(std::string_view("C")), weight));
+    EXPECT_DOUBLE_EQ(weight, 60.0);
+}
+
+TEST(AlgorithmTest, TransitionSketch) {
+    EventLog log = create_test_log();
+    FrequencyAnalyzer analyzer;
+
+    auto sketch = analyzer.sketch_transitions(log, 0.01, 0.01, 3);
+    EXPECT_EQ(sketch.total(), 6);
+    EXPECT_EQ(sketch.estimate("A", "B"), 1);
+    EXPECT_EQ(sketch.estimate("B", "A"), 0);
+
+    TransitionSketch streamed(0.01, 0.01, 3);
+    for (int i = 0; i < 100; ++i) {
+        streamed.add("X", "Y");
+        streamed.add("act" + std::to_string(i), "act" + std::to_string(i + 1));
+    }
+    streamed.add("Y", "Z", 40);
+    streamed.merge(sketch);
+
+    auto top = streamed.top_transitions();
+    ASSERT_EQ(top.size(), 3);
+    EXPECT_EQ(top[0].from, "X");
+    EXPECT_DOUBLE_EQ(top[0].weight, 100.0);
+    EXPECT_EQ(top[1].from, "Y");
+    EXPECT_DOUBLE_EQ(top[1].weight, 40.0);
+
+    auto graph = analyzer.build_process_graph(streamed, 10.0);
+    EXPECT_TRUE(graph->has_edge(std::string_view("X"), std::string_view("Y")));
+    EXPECT_TRUE(graph->has_edge(std::string_view("Y"), std::string_view("Z")));
+    EXPECT_EQ(graph->node_count(), 3);
+}
+
+TEST(AlgorithmTest, CardinalityAnalyzer) {
+    auto start = system_clock::now();
+    EventLog log = test::build_log(2000, [](size_t t) {
+        return std::vector<std::string>{"A", t % 4 == 0 ? "B" : "C", "D"};
+    }, [&](size_t t, size_t index, Event& event) {
+        event.resource = "user" + std::to_string((t + index) % 50);
+        event.timestamp = start + seconds(t);
+    }, start);
+
+    CardinalityAnalyzer analyzer;
+    analyzer.set_parallelism(3);
+    auto metrics = analyzer.analyze(log);
+
+    EXPECT_NEAR(metrics.activity_cases.at("A").estimate(), 2000.0, 100.0);
+    EXPECT_NEAR(metrics.transition_cases.at("A").at("B").estimate(), 500.0, 25.0);
+    EXPECT_NEAR(metrics.activity_resources.at("D").estimate(), 50.0, 2.0);
+
+    auto halves = analyzer.analyze(LogView(log).filter_by_timeframe(start, start + seconds(999)));
+    analyzer.merge(halves, analyzer.analyze(LogView(log).filter_by_timeframe(start + seconds(1000), start + seconds(2000))));
+    EXPECT_DOUBLE_EQ(halves.activity_cases.at("A").estimate(), metrics.activity_cases.at("A").estimate());
+    EXPECT_DOUBLE_EQ(halves.transition_resources.at("C").at("D").estimate(),
+                     metrics.transition_resources.at("C").at("D").estimate());
+}
+
+TEST(AlgorithmTest, VariantTracker) {
+    EventLog log = test::build_log(1000, [](size_t t) {
+        std::vector<std::string> activities = {"A"};
+        if (t % 2 == 0) {
+            activities.push_back("B");
+        } else if (t % 3 == 0) {
+            activities.push_back("C");
+        } else {
+            activities.push_back("rare" + std::to_string(t));
+        }
+        return activities;
+    });
+
+    FrequencyAnalyzer analyzer;
+    auto tracker = analyzer.track_variants(log, 20);
+    auto top = tracker.top(2);
+    ASSERT_EQ(top.size(), 2);
+    EXPECT_EQ(top[0].activities, (std::vector<std::string>{"A", "B"}));
+    EXPECT_GE(top[0].count, 500);
+    EXPECT_LE(top[0].count - top[0].error, 500);
+    EXPECT_EQ(top[1].activities, (std::vector<std::string>{"A", "C"}));
+    EXPECT_EQ(tracker.error_bound(), 50);
+
+    VariantTracker streaming(20);
+    streaming.add(std::vector<std::string>{"A", "C"}, 1000);
+    streaming.merge(tracker);
+    EXPECT_EQ(streaming.top(1)[0].activities, (std::vector<std::string>{"A", "C"}));
+    EXPECT_EQ(streaming.total(), 2000);
+    EXPECT_LT(streaming.memory_usage(), 16 * 1024);
+}
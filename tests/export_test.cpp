@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "procmine/export.h"
+#include <cstdio>
+#include <fcntl.h>
+#include <sstream>
+#include <unistd.h>
+
+namespace {
+    using namespace procmine;
+
+    ProcessGraph create_test_graph() {
+        ProcessGraph graph;
+        graph.add_edge("A", "B", 2.5);
+        graph.add_edge("B", "say \"hi\"\\now", 1.0);
+        graph.add_edge("A", "say \"hi\"\\now", 0.125);
+        return graph;
+    }
+}
+
+TEST(ExportTest, TextFormats) {
+    ProcessGraph graph = create_test_graph();
+
+    std::string dot = graph.to_dot();
+    EXPECT_EQ(dot,
+              "digraph G {\n"
+              "0[label=\"A\", shape=box];\n"
+              "1[label=\"B\", shape=box];\n"
+              "2[label=\"say \\\"hi\\\"\\\\now\", shape=box];\n"
+              "0->1 [label=\"2.5\"];\n"
+              "0->2 [label=\"0.125\"];\n"
+              "1->2 [label=\"1\"];\n"
+              "}\n");
+
+    std::ostringstream small_buffer;
+    DOTGraphWriter writer(small_buffer);
+    writer.set_buffer_size(7);
+    writer.write(graph);
+    EXPECT_EQ(small_buffer.str(), dot);
+
+    std::ostringstream json;
+    JSONGraphWriter(json).write(graph);
+    EXPECT_EQ(json.str(),
+              "{\"nodes\":[{\"id\":0,\"label\":\"A\"},{\"id\":1,\"label\":\"B\"},"
+              "{\"id\":2,\"label\":\"say \\\"hi\\\"\\\\now\"}],"
+              "\"edges\":[{\"source\":0,\"target\":1,\"weight\":2.5},"
+              "{\"source\":0,\"target\":2,\"weight\":0.125},"
+              "{\"source\":1,\"target\":2,\"weight\":1}]}\n");
+}
+
+TEST(ExportTest, BinaryRoundTrip) {
+    ProcessGraph graph = create_test_graph();
+
+    std::stringstream buffer;
+    BinaryGraphWriter(buffer).write(graph);
+    auto loaded = BinaryGraphReader(buffer).read();
+    EXPECT_EQ(loaded->to_dot(), graph.to_dot());
+
+    std::string path = "export_test_graph.bin";
+    int fd = ::open(path.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+    ASSERT_GE(fd, 0);
+    BinaryGraphWriter(fd).write(graph);
+    ::close(fd);
+
+    fd = ::open(path.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+    auto from_fd = BinaryGraphReader(fd).read();
+    ::close(fd);
+    std::remove(path.c_str());
+
+    double weight = 0.0;
+    ASSERT_TRUE(from_fd->find_edge(from_fd->find_node(std::string_view("A")),
+                                   from_fd->find_node(std::string_view("say \"hi\"\\now")), weight));
+    EXPECT_DOUBLE_EQ(weight, 0.125);
+
+    std::stringstream truncated(buffer.str().substr(0, 10));
+    EXPECT_THROW(BinaryGraphReader(truncated).read(), std::runtime_error);
+
+    std::stringstream oversized(std::string("PMG1\1\0\0\0\0\0\0\0\xff\xff\xff\xff" "AB", 18));
+    EXPECT_THROW(BinaryGraphReader(oversized).read(), std::runtime_error);
+}
+
+TEST(ExportTest, BinaryReaderLeavesTrailingData) {
+    ProcessGraph graph = create_test_graph();
+
+    std::stringstream buffer;
+    BinaryGraphWriter(buffer).write(graph);
+    buffer << "tail";
+    BinaryGraphReader(buffer).read();
+    std::string rest;
+    buffer >> rest;
+    EXPECT_EQ(rest, "tail");
+
+    std::string path = "export_test_trailing.bin";
+    int fd = ::open(path.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+    ASSERT_GE(fd, 0);
+    BinaryGraphWriter(fd).write(graph);
+    ASSERT_EQ(::write(fd, "tail", 4), 4);
+    ::close(fd);
+
+    fd = ::open(path.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+    BinaryGraphReader(fd).read();
+    char tail[8] = {};
+    EXPECT_EQ(::read(fd, tail, sizeof(tail)), 4);
+    ::close(fd);
+    std::remove(path.c_str());
+    EXPECT_EQ(std::string(tail, 4), "tail");
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "procmine/filter.h"
+#include "procmine/models.h"
+#include <chrono>
+
+namespace {
+    using namespace procmine;
+    using namespace std::chrono;
+
+    EventLog create_test_log() {
+        EventLog log;
+        auto start = system_clock::now();
+
+        std::vector<std::vector<std::string>> variants = {
+            {"A", "B", "C"},
+            {"A", "C", "B"},
+            {"A", "B", "C"},
+            {"B", "D"}
+        };
+
+        for (size_t t = 0; t < variants.size(); ++t) {
+            Trace trace("case" + std::to_string(t + 1));
+            for (size_t i = 0; i < variants[t].size(); ++i) {
+                Event event;
+                event.activity = variants[t][i];
+                event.resource = i % 2 == 0 ? "user1" : "user2";
+                event.timestamp = start + seconds(t * 10 + i);
+                event.attributes["priority"] = t == 1 ? "high" : "low";
+                trace.add_event(event);
+            }
+            log.add_trace(trace);
+        }
+
+        return log;
+    }
+}
+
+TEST(FilterTest, BitmapOperations) {
+    Bitmap sparse;
+    sparse.add(3);
+    sparse.add(70000);
+    sparse.add(1);
+    sparse.add(3);
+    EXPECT_EQ(sparse.cardinality(), 3);
+    EXPECT_TRUE(sparse.contains(70000));
+    EXPECT_FALSE(sparse.contains(2));
+
+    Bitmap dense = Bitmap::range(0, 10000);
+    EXPECT_EQ(dense.cardinality(), 10000);
+
+    EXPECT_EQ((sparse & dense).to_vector(), (std::vector<uint32_t>{1, 3}));
+    EXPECT_EQ((sparse | dense).cardinality(), 10001);
+    EXPECT_EQ(dense.and_not(sparse).cardinality(), 9998);
+    EXPECT_EQ(sparse.and_not(dense).to_vector(), (std::vector<uint32_t>{70000}));
+
+    Bitmap evens;
+    for (uint32_t value = 0; value < 20000; value += 2) {
+        evens.add(value);
+    }
+    EXPECT_EQ((evens & dense).cardinality(), 5000);
+    EXPECT_TRUE(dense.and_not(dense).empty());
+}
+
+TEST(FilterTest, PredicateEvaluation) {
+    EventLog log = create_test_log();
+    FilterEngine engine(log);
+
+    EXPECT_EQ(engine.event_count(), 11);
+    EXPECT_EQ(engine.activity_events("B").cardinality(), 4);
+    EXPECT_TRUE(engine.activity_events("missing").empty());
+
+    auto events = engine.select_events(Predicate::activity("B") && Predicate::resource("user2"));
+    EXPECT_EQ(events.size(), 2);
+    EXPECT_EQ(events.event_count(), 2);
+
+    auto variant = engine.select_traces(Predicate::variant({"A", "B", "C"}));
+    ASSERT_EQ(variant.size(), 2);
+    EXPECT_EQ(variant.get_trace(0).get_case_id(), "case1");
+    EXPECT_EQ(variant.get_trace(1).get_case_id(), "case3");
+
+    auto follows = engine.matching_traces(Predicate::eventually_follows("C", "B"));
+    EXPECT_EQ(follows.to_vector(), (std::vector<uint32_t>{1}));
+
+    auto complex = engine.select_traces((Predicate::trace_length(3, 3) && !Predicate::attribute("priority", "high"))
+                                        || Predicate::case_id("case4"));
+    EXPECT_EQ(complex.size(), 3);
+    EXPECT_EQ(complex.event_count(), 8);
+
+    EventLog columnar = log;
+    columnar.columnarize_attributes();
+    FilterEngine columnar_engine(columnar);
+    EXPECT_EQ(columnar_engine.evaluate(Predicate::attribute("priority", "high")).to_vector(),
+              engine.evaluate(Predicate::attribute("priority", "high")).to_vector());
+
+    auto mined = engine.select_events(!Predicate::activity("D")).materialize();
+    EXPECT_EQ(mined->get_traces().size(), 4);
+    EXPECT_EQ(mined->get_traces()[3].get_events().size(), 1);
+}
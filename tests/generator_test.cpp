@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include "procmine/generator.h"
+#include "procmine/log.h"
+#include <filesystem>
+
+namespace {
+    using namespace procmine;
+
+    ProcessGraph create_model() {
+        ProcessGraph model;
+        model.add_edge("register", "check", 1.0);
+        model.add_edge("check", "approve", 3.0);
+        model.add_edge("check", "reject", 1.0);
+        model.add_edge("approve", "check", 1.0);
+        model.add_edge("approve", "archive", 1.0);
+        model.add_edge("reject", "archive", 1.0);
+        return model;
+    }
+}
+
+TEST(GeneratorTest, ModelPlayout) {
+    ProcessGraph model = create_model();
+    LogGenerator generator(model);
+    generator.set_seed(17);
+    generator.set_duration("approve", 600.0, 120.0);
+    generator.set_resource_count(5);
+
+    FrequencyAnalyzer analyzer;
+    auto weighted = analyzer.analyze(*generator.generate(2000));
+    double approve = weighted.transition_frequency["check"]["approve"];
+    double reject = weighted.transition_frequency["check"]["reject"];
+    EXPECT_NEAR(approve / (approve + reject), 0.75, 0.05);
+
+    generator.set_loop_probability(0.2);
+    auto serial = generator.generate(2000);
+    generator.set_parallelism(4);
+    auto parallel = generator.generate(2000);
+
+    ASSERT_EQ(serial->get_traces().size(), 2000);
+    ASSERT_EQ(parallel->get_traces().size(), 2000);
+    for (size_t t = 0; t < 2000; ++t) {
+        const auto& a = serial->get_traces()[t].get_events();
+        const auto& b = parallel->get_traces()[t].get_events();
+        ASSERT_EQ(a.size(), b.size());
+        for (size_t i = 0; i < a.size(); ++i) {
+            EXPECT_EQ(a[i].activity, b[i].activity);
+            EXPECT_EQ(a[i].timestamp, b[i].timestamp);
+            EXPECT_EQ(a[i].resource, b[i].resource);
+        }
+        EXPECT_EQ(a.front().activity, "register");
+        EXPECT_EQ(a.back().activity, "archive");
+    }
+
+    auto looped = analyzer.analyze(*serial);
+    double loops = looped.transition_frequency["approve"]["check"];
+    EXPECT_NEAR(loops / looped.activity_frequency["approve"], 0.2, 0.05);
+
+    ConformanceChecker checker(model);
+    EXPECT_DOUBLE_EQ(checker.calculate_overall_conformance(*serial), 1.0);
+
+    generator.set_noise(0.3);
+    EXPECT_LT(checker.calculate_overall_conformance(*generator.generate(500)), 1.0);
+    EXPECT_EQ(generator.generate(10, 1990)->get_traces()[3].get_case_id(), "case1993");
+    EXPECT_THROW(generator.set_duration("missing", 1.0), std::runtime_error);
+}
+
+TEST(GeneratorTest, WritesBatchesToCSV) {
+    ProcessGraph model = create_model();
+    LogGenerator generator(model);
+    generator.set_seed(5);
+    generator.set_batch_size(7);
+
+    std::string path = "generator_test.csv";
+    generator.write_csv(path, 30);
+    auto loaded = CSVLogReader(path).read();
+    std::filesystem::remove(path);
+
+    auto expected = generator.generate(30);
+    ASSERT_EQ(loaded->get_traces().size(), 30);
+    for (size_t t = 0; t < 30; ++t) {
+        EXPECT_EQ(loaded->get_traces()[t].get_case_id(), expected->get_traces()[t].get_case_id());
+        EXPECT_EQ(loaded->get_traces()[t].get_events().size(), expected->get_traces()[t].get_events().size());
+    }
+}
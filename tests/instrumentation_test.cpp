@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include "procmine/instrumentation.h"
+#include "procmine/log.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace {
+    using namespace procmine;
+
+    class InstrumentationTest : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            Instrumentation::instance().reset();
+            Instrumentation::instance().set_enabled(true);
+        }
+
+        void TearDown() override {
+            Instrumentation::instance().reset();
+            Instrumentation::instance().set_enabled(PROCMINE_INSTRUMENTATION != 0);
+        }
+    };
+}
+
+TEST_F(InstrumentationTest, SpansAndCounters) {
+    Instrumentation& instrumentation = Instrumentation::instance();
+    {
+        ScopedSpan outer("stage \"one\"");
+        ScopedSpan inner("stage.two");
+    }
+    instrumentation.add_counter("rows", 3);
+    instrumentation.add_counter("rows", 4);
+
+    auto spans = instrumentation.get_spans();
+    ASSERT_EQ(spans.size(), 2u);
+    EXPECT_EQ(spans[0].name, "stage.two");
+    EXPECT_EQ(spans[1].name, "stage \"one\"");
+    EXPECT_LE(spans[1].start_us, spans[0].start_us);
+    EXPECT_EQ(instrumentation.get_counters().at("rows"), 7);
+
+    std::ostringstream trace;
+    instrumentation.write_chrome_trace(trace);
+    EXPECT_EQ(trace.str().rfind("{\"traceEvents\":[", 0), 0u);
+    EXPECT_NE(trace.str().find("\"name\":\"stage \\\"one\\\"\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(trace.str().find("\"name\":\"rows\",\"ph\":\"C\""), std::string::npos);
+    EXPECT_NE(trace.str().find("\"args\":{\"value\":7}"), std::string::npos);
+
+    std::ostringstream metrics;
+    instrumentation.write_metrics(metrics);
+    EXPECT_NE(metrics.str().find("counter rows 7\n"), std::string::npos);
+    EXPECT_NE(metrics.str().find("span stage.two count=1 total_us="), std::string::npos);
+
+    instrumentation.set_enabled(false);
+    instrumentation.add_counter("rows", 1);
+    { ScopedSpan ignored("ignored"); }
+    EXPECT_EQ(instrumentation.get_counters().at("rows"), 7);
+    EXPECT_EQ(instrumentation.get_spans().size(), 2u);
+
+    instrumentation.reset();
+    EXPECT_TRUE(instrumentation.get_counters().empty());
+    EXPECT_TRUE(instrumentation.get_spans().empty());
+}
+
+TEST_F(InstrumentationTest, CSVReaderCountsSkippedRows) {
+    std::string path = "instrumentation_test.csv";
+    {
+        std::ofstream out(path);
+        out << "case_id,activity,timestamp\n"
+            << "1,A,2024-01-01 10:00:00\n"
+            << "1,B\n"
+            << "2,A,2024-01-01 11:00:00,extra\n"
+            << "2,C,2024-01-01 12:00:00\n";
+    }
+
+    CSVLogReader reader(path);
+    auto log = reader.read();
+    std::remove(path.c_str());
+
+    EXPECT_EQ(log->get_traces().size(), 2u);
+    EXPECT_EQ(reader.get_skipped_rows(), 2u);
+
+#if PROCMINE_INSTRUMENTATION
+    auto counters = Instrumentation::instance().get_counters();
+    EXPECT_EQ(counters.at("csv.rows_read"), 4);
+    EXPECT_EQ(counters.at("csv.rows_skipped"), 2);
+    EXPECT_EQ(counters.at("csv.events_read"), 2);
+    EXPECT_GT(counters.at("memory.arena_bytes"), 0);
+    ASSERT_FALSE(Instrumentation::instance().get_spans().empty());
+    EXPECT_EQ(Instrumentation::instance().get_spans().back().name, "csv.read");
+#endif
+}
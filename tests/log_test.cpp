@@ -1,8 +1,16 @@
 #include <gtest/gtest.h>
 #include "procmine/log.h"
 #include "procmine/models.h"
+#include "procmine/database.h"
+#include "procmine/sampling.h"
+#include "test_logs.h"
+#include <algorithm>
 #include <fstream>
 #include <filesystem>
+#include <iterator>
+#include <iomanip>
+#include <sstream>
+#include <unordered_set>
 
 namespace {
     using namespace procmine;
@@ -61,6 +69,47 @@ namespace {
         
         return log;
     }
+
+    std::string read_file(const std::string& path) {
+        std::ifstream file(path);
+        return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+
+    std::string legacy_csv(const EventLog& log) {
+        std::ostringstream out;
+        out << "case_id,activity,timestamp,resource";
+
+        std::unordered_set<std::string> attribute_names;
+        for (const auto& trace : log.get_traces()) {
+            for (const auto& event : trace.get_events()) {
+                for (const auto& attr : event.attributes) {
+                    attribute_names.insert(attr.first);
+                }
+            }
+        }
+        for (const auto& name : attribute_names) {
+            out << ',' << name;
+        }
+        out << '\n';
+
+        for (const auto& trace : log.get_traces()) {
+            for (const auto& event : trace.get_events()) {
+                auto time_t = system_clock::to_time_t(event.timestamp);
+                std::tm tm = *std::localtime(&time_t);
+                out << trace.get_case_id() << ',' << event.activity << ','
+                    << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << ',' << event.resource;
+                for (const auto& name : attribute_names) {
+                    out << ',';
+                    auto it = event.attributes.find(name);
+                    if (it != event.attributes.end()) {
+                        out << it->second;
+                    }
+                }
+                out << '\n';
+            }
+        }
+        return out.str();
+    }
 }
 
 TEST(LogTest, CSVLogReader) {
@@ -142,4 +191,502 @@ TEST(LogTest, LogFiltering) {
     auto future_time = system_clock::now() + hours(48);
     auto filtered_by_time = log.filter_by_timeframe(future_time, future_time + hours(24));
     EXPECT_EQ(filtered_by_time->get_traces().size(), 0);
-} 
\ No newline at end of file
+}
+
+TEST(LogTest, SQLiteLogWriterBulkMode) {
+    EventLog log = create_test_log();
+
+    std::string db_path = "bulk_log.db";
+    std::filesystem::remove(db_path);
+
+    SQLiteLogWriter writer(db_path, "events");
+    writer.set_bulk_mode(true);
+    writer.set_batch_size(2);
+    writer.set_create_indexes(true);
+    writer.write(log);
+
+    SQLiteLogReader reader(db_path, "SELECT * FROM events ORDER BY id");
+    auto read_log = reader.read();
+
+    size_t event_count = 0;
+    for (const auto& trace : read_log->get_traces()) {
+        event_count += trace.get_events().size();
+    }
+    EXPECT_EQ(read_log->get_traces().size(), 2);
+    EXPECT_EQ(event_count, 3);
+
+    Database db(db_path);
+    EXPECT_EQ(db.query("PRAGMA journal_mode")->get_string(0, 0), "delete");
+    auto indexes = db.query("SELECT name FROM sqlite_master WHERE type = 'index' AND tbl_name = 'events'");
+    EXPECT_EQ(indexes->get_row_count(), 2);
+
+    std::filesystem::remove(db_path);
+}
+
+TEST(LogTest, SQLiteNormalizedLayout) {
+    EventLog log = create_test_log();
+
+    std::string db_path = "normalized_log.db";
+    std::filesystem::remove(db_path);
+
+    SQLiteLogWriter writer(db_path, "events");
+    writer.set_layout(SQLiteLayout::Normalized);
+    writer.set_create_indexes(true);
+    writer.write(log);
+
+    SQLiteLogReader reader(db_path, "");
+    reader.set_table("events", SQLiteLayout::Normalized);
+    auto read_log = reader.read();
+
+    const auto& traces = read_log->get_traces();
+    ASSERT_EQ(traces.size(), 2);
+    EXPECT_EQ(traces[0].get_case_id(), "case1");
+    ASSERT_EQ(traces[0].get_events().size(), 2);
+
+    const auto& original = log.get_traces()[0].get_events()[1];
+    const auto& event = traces[0].get_events()[1];
+    EXPECT_EQ(event.activity, "B");
+    EXPECT_EQ(event.resource, "user2");
+    EXPECT_EQ(event.attributes.at("cost"), "150");
+    EXPECT_EQ(event.attributes.at("priority"), "medium");
+    EXPECT_EQ(system_clock::to_time_t(event.timestamp), system_clock::to_time_t(original.timestamp));
+
+    Database db(db_path);
+    EXPECT_EQ(db.query("SELECT COUNT(*) FROM events_activities")->get_int(0, 0), 2);
+    EXPECT_EQ(db.query("SELECT COUNT(*) FROM events_attributes")->get_int(0, 0), 6);
+
+    std::filesystem::remove(db_path);
+}
+
+TEST(LogTest, SQLiteLogWriterQuotesAttributeNames) {
+    EventLog log;
+    Trace trace("case1");
+    Event event;
+    event.activity = "A";
+    event.timestamp = system_clock::now();
+    event.attributes["unit \"cost\""] = "10";
+    trace.add_event(event);
+    log.add_trace(trace);
+
+    std::string db_path = "quoted_log.db";
+    std::filesystem::remove(db_path);
+
+    SQLiteLogWriter writer(db_path, "events");
+    writer.write(log);
+
+    SQLiteLogReader reader(db_path, "SELECT * FROM events");
+    auto read_log = reader.read();
+    ASSERT_EQ(read_log->get_traces().size(), 1);
+    EXPECT_EQ(read_log->get_traces()[0].get_events()[0].attributes.at("unit \"cost\""), "10");
+
+    std::filesystem::remove(db_path);
+}
+
+TEST(LogTest, SQLiteLogReaderFilterPushdown) {
+    std::string csv_path = create_test_csv();
+    auto log = CSVLogReader(csv_path).read();
+
+    std::string db_path = "filtered_log.db";
+    std::filesystem::remove(db_path);
+
+    SQLiteLogWriter flat_writer(db_path, "flat_events");
+    flat_writer.write(*log);
+
+    SQLiteLogWriter normalized_writer(db_path, "events");
+    normalized_writer.set_layout(SQLiteLayout::Normalized);
+    normalized_writer.write(*log);
+
+    const auto& case1 = log->get_traces()[0].get_events();
+
+    LogFilter filter;
+    filter.start = case1[1].timestamp;
+    filter.activities = {"B", "C"};
+    filter.attributes["priority"] = "low";
+
+    for (auto layout : {SQLiteLayout::Flat, SQLiteLayout::Normalized}) {
+        SQLiteLogReader reader(db_path, "");
+        reader.set_table(layout == SQLiteLayout::Flat ? "flat_events" : "events", layout);
+        reader.set_filter(filter);
+        reader.create_filter_indexes();
+
+        auto filtered = reader.read();
+        ASSERT_EQ(filtered->get_traces().size(), 1);
+        EXPECT_EQ(filtered->get_traces()[0].get_case_id(), "case1");
+        ASSERT_EQ(filtered->get_traces()[0].get_events().size(), 1);
+        EXPECT_EQ(filtered->get_traces()[0].get_events()[0].activity, "C");
+    }
+
+    LogFilter case_filter;
+    case_filter.case_ids = {"case2"};
+    SQLiteLogReader query_reader(db_path, "SELECT * FROM flat_events");
+    query_reader.set_filter(case_filter);
+    auto case2 = query_reader.read();
+    ASSERT_EQ(case2->get_traces().size(), 1);
+    EXPECT_EQ(case2->get_traces()[0].get_events().size(), 3);
+
+    std::filesystem::remove(db_path);
+    std::filesystem::remove(csv_path);
+}
+
+TEST(LogTest, SQLiteFilterPushdownNormalizesTimestamps) {
+    std::string db_path = "iso_filter.db";
+    std::filesystem::remove(db_path);
+    {
+        Database db(db_path);
+        ASSERT_TRUE(db.execute("CREATE TABLE events (id INTEGER PRIMARY KEY AUTOINCREMENT, case_id TEXT, "
+                               "activity TEXT, timestamp TEXT, resource TEXT)"));
+        ASSERT_TRUE(db.execute("INSERT INTO events (case_id, activity, timestamp, resource) VALUES "
+                               "('case1', 'A', '2024-01-01T09:00:00', 'user1'), "
+                               "('case1', 'B', '2024-01-01T10:00:00', 'user1'), "
+                               "('case1', 'C', '2024-01-01 10:30:00', 'user2'), "
+                               "('case2', 'A', '2024-01-01T11:00:00', 'user2')"));
+    }
+
+    auto full = SQLiteLogReader(db_path, "SELECT * FROM events ORDER BY id").read();
+    LogFilter filter;
+    filter.start = full->get_traces()[0].get_events()[1].timestamp;
+    filter.end = full->get_traces()[0].get_events()[2].timestamp;
+
+    SQLiteLogReader reader(db_path, "");
+    reader.set_table("events");
+    reader.set_filter(filter);
+    reader.create_filter_indexes();
+    auto filtered = reader.read();
+
+    ASSERT_EQ(filtered->get_traces().size(), 1);
+    const auto& events = filtered->get_traces()[0].get_events();
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_EQ(events[0].activity, "B");
+    EXPECT_EQ(events[1].activity, "C");
+
+    std::filesystem::remove(db_path);
+}
+
+TEST(LogTest, SQLiteLogReaderParallel) {
+    EventLog log = test::build_log(40, [](size_t) { return std::vector<std::string>{"A", "B", "C", "D", "E"}; },
+        [](size_t c, size_t e, Event& event) {
+            event.resource = "user" + std::to_string(c % 3);
+            event.attributes["step"] = std::to_string(e);
+        });
+
+    std::string db_path = "parallel_log.db";
+    std::filesystem::remove(db_path);
+
+    SQLiteLogWriter flat_writer(db_path, "flat_events");
+    flat_writer.write(log);
+
+    SQLiteLogWriter normalized_writer(db_path, "events");
+    normalized_writer.set_layout(SQLiteLayout::Normalized);
+    normalized_writer.write(log);
+
+    for (auto layout : {SQLiteLayout::Flat, SQLiteLayout::Normalized}) {
+        SQLiteLogReader reader(db_path, "");
+        reader.set_table(layout == SQLiteLayout::Flat ? "flat_events" : "events", layout);
+        reader.set_parallelism(4);
+        auto read_log = reader.read();
+
+        const auto& traces = read_log->get_traces();
+        ASSERT_EQ(traces.size(), 40);
+        for (size_t c = 0; c < traces.size(); ++c) {
+            EXPECT_EQ(traces[c].get_case_id(), "case" + std::to_string(c));
+            const auto& events = traces[c].get_events();
+            ASSERT_EQ(events.size(), 5);
+            for (size_t e = 0; e < events.size(); ++e) {
+                EXPECT_EQ(events[e].attributes.at("step"), std::to_string(e));
+            }
+        }
+    }
+
+    ASSERT_TRUE(Database(db_path).execute("PRAGMA journal_mode=WAL"));
+    SQLiteLogReader wal_reader(db_path, "");
+    wal_reader.set_table("flat_events");
+    wal_reader.set_parallelism(4);
+    EXPECT_EQ(wal_reader.read()->get_traces().size(), 40);
+
+    std::filesystem::remove(db_path);
+    std::filesystem::remove(db_path + "-wal");
+    std::filesystem::remove(db_path + "-shm");
+}
+
+TEST(LogTest, AsyncLogWriters) {
+    auto log = std::make_shared<EventLog>(create_test_log());
+
+    std::string sync_csv = "sync_log.csv";
+    std::string async_csv = "async_log.csv";
+    CSVLogWriter(sync_csv).write(*log);
+
+    auto csv_done = CSVLogWriter(async_csv).write_async(log);
+
+    std::string db_path = "async_log.db";
+    std::filesystem::remove(db_path);
+    SQLiteLogWriter sqlite_writer(db_path, "events");
+    sqlite_writer.set_batch_size(2);
+    auto sqlite_done = sqlite_writer.write_async(log, 1);
+
+    csv_done.get();
+    sqlite_done.get();
+
+    EXPECT_EQ(read_file(sync_csv), read_file(async_csv));
+
+    SQLiteLogReader reader(db_path, "SELECT * FROM events ORDER BY id");
+    auto read_log = reader.read();
+    ASSERT_EQ(read_log->get_traces().size(), 2);
+    EXPECT_EQ(read_log->get_traces()[0].get_events().size(), 2);
+    EXPECT_EQ(read_log->get_traces()[0].get_events()[1].attributes.at("cost"), "150");
+
+    std::filesystem::remove(sync_csv);
+    std::filesystem::remove(async_csv);
+    std::filesystem::remove(db_path);
+}
+
+TEST(LogTest, AsyncSQLiteWriterReportsInsertFailure) {
+    auto log = std::make_shared<EventLog>(test::build_log(2000, [](size_t) {
+        return std::vector<std::string>{"A", "B", "C", "D", "E", "F", "G", "H", "I", "J"};
+    }, [](size_t, size_t e, Event& event) {
+        event.attributes["step"] = std::to_string(e);
+        event.attributes["missing"] = "x";
+    }));
+
+    std::string db_path = (std::filesystem::temp_directory_path() / "procmine_async_failure.db").string();
+    std::filesystem::remove(db_path);
+    {
+        Database db(db_path);
+        ASSERT_TRUE(db.execute("CREATE TABLE events (id INTEGER PRIMARY KEY AUTOINCREMENT, case_id TEXT, "
+                               "activity TEXT, timestamp TEXT, resource TEXT, step TEXT)"));
+    }
+
+    SQLiteLogWriter writer(db_path, "events");
+    writer.set_batch_size(2);
+    auto done = writer.write_async(log, 1);
+    EXPECT_THROW(done.get(), std::runtime_error);
+
+    EXPECT_EQ(Database(db_path).query("SELECT COUNT(*) FROM events")->get_int(0, 0), 0);
+
+    std::filesystem::remove(db_path);
+}
+
+TEST(LogTest, CSVLogWriterModes) {
+    EventLog log = create_test_log();
+
+    std::string compat_csv = "compat_log.csv";
+    CSVLogWriter compat_writer(compat_csv);
+    compat_writer.set_compatibility_mode(true);
+    compat_writer.write(log);
+    EXPECT_EQ(read_file(compat_csv), legacy_csv(log));
+
+    std::string serial_csv = "serial_log.csv";
+    CSVLogWriter(serial_csv).write(log);
+    std::string serial_content = read_file(serial_csv);
+    EXPECT_EQ(serial_content.substr(0, serial_content.find('\n')),
+              "case_id,activity,timestamp,resource,cost,priority");
+
+    std::string parallel_csv = "parallel_log.csv";
+    CSVLogWriter parallel_writer(parallel_csv);
+    parallel_writer.set_parallelism(3);
+    parallel_writer.write(log);
+    EXPECT_EQ(read_file(parallel_csv), serial_content);
+
+    std::filesystem::remove(compat_csv);
+    std::filesystem::remove(serial_csv);
+    std::filesystem::remove(parallel_csv);
+}
+
+TEST(LogTest, LogViewComposition) {
+    EventLog log = create_test_log();
+
+    LogView view(log);
+    EXPECT_EQ(view.size(), 2);
+    EXPECT_EQ(view.event_count(), 3);
+
+    auto early = log.get_traces()[0].get_events()[0].timestamp;
+    auto filtered = view.filter_by_timeframe(early, early + hours(1)).filter_by_activity("B");
+    ASSERT_EQ(filtered.size(), 1);
+    EXPECT_EQ(filtered.get_trace(0).get_case_id(), "case1");
+    ASSERT_EQ(filtered.get_trace(0).size(), 1);
+    EXPECT_EQ(filtered.get_trace(0)[0].activity, "B");
+    EXPECT_EQ(&filtered.get_trace(0)[0], &log.get_traces()[0].get_events()[1]);
+
+    auto long_traces = view.filter_traces([](const TraceView& trace) { return trace.size() > 1; });
+    ASSERT_EQ(long_traces.size(), 1);
+    EXPECT_EQ(long_traces.trace_index(0), 0);
+    EXPECT_EQ(std::distance(view.begin(), view.end()), 2);
+
+    TraceView first = view.get_trace(0);
+    std::vector<Event> events(first.begin(), first.end());
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_EQ(first.end() - first.begin(), 2);
+    EXPECT_EQ(first.begin()[1].activity, "B");
+    EXPECT_EQ((--first.end())->activity, "B");
+    EXPECT_TRUE(first.begin() < first.end());
+
+    auto materialized = filtered.materialize();
+    ASSERT_EQ(materialized->get_traces().size(), 1);
+    EXPECT_EQ(materialized->get_traces()[0].get_events()[0].attributes.at("cost"), "150");
+}
+
+TEST(LogTest, TimeIndexQueries) {
+    auto start = system_clock::now();
+    EventLog source = test::build_log(50, [](size_t) { return std::vector<std::string>{"A", "B", "C"}; },
+        [&](size_t t, size_t i, Event& event) {
+            int offset = t == 7 ? -100 : static_cast<int>(t) * 10;
+            event.timestamp = start + seconds(offset + (i == 1 ? 5 : static_cast<int>(i)));
+        }, start);
+
+    EventLog log;
+    log.build_time_index();
+    for (const auto& trace : source.get_traces()) {
+        log.add_trace(trace);
+    }
+
+    ASSERT_NE(log.get_time_index(), nullptr);
+    EXPECT_EQ(log.get_time_index()->size(), 150);
+
+    auto window_start = start + seconds(100);
+    auto window_end = start + seconds(121);
+    auto indexed = LogView(log).filter_by_timeframe(window_start, window_end);
+    auto subset = LogView(log).filter_by_activity("B").filter_by_timeframe(window_start, window_end);
+
+    EventLog plain;
+    for (const auto& trace : log.get_traces()) {
+        plain.add_trace(trace);
+    }
+    auto scanned = LogView(plain).filter_by_timeframe(window_start, window_end);
+
+    ASSERT_EQ(indexed.size(), scanned.size());
+    EXPECT_EQ(indexed.event_count(), scanned.event_count());
+    for (size_t i = 0; i < indexed.size(); ++i) {
+        EXPECT_EQ(indexed.trace_index(i), scanned.trace_index(i));
+    }
+    EXPECT_EQ(indexed.size(), 3);
+    EXPECT_EQ(indexed.event_count(), 7);
+    EXPECT_EQ(subset.event_count(), 2);
+
+    auto early = log.filter_by_timeframe(start - seconds(100), start - seconds(99));
+    ASSERT_EQ(early->get_traces().size(), 1);
+    EXPECT_EQ(early->get_traces()[0].get_case_id(), "case7");
+}
+
+TEST(LogTest, ArenaBackedEventLog) {
+    std::string filepath = create_test_csv();
+    CSVLogReader reader(filepath);
+    auto log = reader.read();
+
+    std::pmr::memory_resource* arena = log->get_allocator().resource();
+    EXPECT_NE(arena, std::pmr::get_default_resource());
+    for (const auto& trace : log->get_traces()) {
+        EXPECT_EQ(trace.get_allocator().resource(), arena);
+        for (const auto& event : trace.get_events()) {
+            EXPECT_EQ(event.get_allocator().resource(), arena);
+        }
+    }
+
+    EventLog copy(*log);
+    EXPECT_EQ(copy.get_traces()[0].get_allocator().resource(), std::pmr::get_default_resource());
+    EXPECT_EQ(copy.get_traces()[0].get_events()[1].attributes.at("cost"), "150");
+
+    EventLog moved(std::move(*log));
+    EXPECT_EQ(moved.get_traces()[0].get_allocator().resource(), arena);
+
+    Trace trace("case3");
+    Event event;
+    event.activity = "D";
+    event.attributes["cost"] = "10";
+    trace.add_event(event);
+    moved.add_trace(trace);
+    EXPECT_EQ(moved.get_traces().back().get_events()[0].get_allocator().resource(), arena);
+    EXPECT_EQ(moved.get_traces().back().get_events()[0].attributes.at("cost"), "10");
+
+    EventLog target;
+    {
+        EventLog source;
+        source.use_arena();
+        Trace foreign("case4", source.get_allocator());
+        Event foreign_event(source.get_allocator());
+        foreign_event.activity = "E";
+        foreign_event.attributes["cost"] = "20";
+        foreign.add_event(std::move(foreign_event));
+        target.add_trace(std::move(foreign));
+    }
+    EXPECT_EQ(target.get_traces()[0].get_allocator().resource(), target.get_allocator().resource());
+    EXPECT_EQ(target.get_traces()[0].get_events()[0].attributes.at("cost"), "20");
+
+    std::filesystem::remove(filepath);
+}
+
+TEST(LogTest, ColumnarAttributes) {
+    std::string filepath = create_test_csv();
+
+    CSVLogReader reader(filepath);
+    reader.set_columnar_attributes(true);
+    reader.set_attribute_type("cost", AttributeType::Int64);
+    auto log = reader.read();
+
+    const auto& schema = log->get_attribute_schema();
+    ASSERT_NE(schema, nullptr);
+    EXPECT_EQ(schema->column_count(), 2);
+    EXPECT_EQ(schema->row_count(), 6);
+
+    const Event& event = log->get_traces()[0].get_events()[1];
+    EXPECT_TRUE(event.attributes.empty());
+    const AttributeColumn* cost = schema->find_column("cost");
+    ASSERT_NE(cost, nullptr);
+    EXPECT_EQ(cost->get_int64(event.attribute_row), 150);
+    EXPECT_EQ(schema->find_column("priority")->get_dictionary().size(), 3);
+
+    std::string value;
+    ASSERT_TRUE(log->get_event_attribute(event, "priority", value));
+    EXPECT_EQ(value, "medium");
+    EXPECT_EQ(log->get_event_attributes(event).at("cost"), "150");
+
+    auto high = cost->equals("120");
+    EXPECT_EQ(std::count(high.begin(), high.end(), 1), 1);
+    auto invalid = cost->equals("not a number");
+    EXPECT_EQ(std::count(invalid.begin(), invalid.end(), 1), 0);
+
+    auto filtered = log->filter_by_activity("B");
+    ASSERT_EQ(filtered->get_traces().size(), 2);
+    EXPECT_EQ(filtered->get_event_attributes(filtered->get_traces()[1].get_events()[0]).at("cost"), "90");
+
+    CSVLogWriter(filepath + ".columnar").write(*log);
+    CSVLogWriter(filepath + ".rows").write(*CSVLogReader(filepath).read());
+    EXPECT_EQ(read_file(filepath + ".columnar"), read_file(filepath + ".rows"));
+
+    EventLog converted = *CSVLogReader(filepath).read();
+    converted.columnarize_attributes({{"cost", AttributeType::Double}});
+    EXPECT_EQ(converted.get_attribute_schema()->find_column("cost")->get_type(), AttributeType::Double);
+    EXPECT_TRUE(converted.get_traces()[1].get_events()[0].attributes.empty());
+    EXPECT_EQ(converted.get_event_attributes(converted.get_traces()[1].get_events()[0]).at("cost"), "120");
+
+    EventLog copy(*log);
+    EXPECT_NE(copy.get_attribute_schema(), log->get_attribute_schema());
+    auto materialized = LogView(*log).materialize();
+    Trace extra("case3");
+    Event extra_event;
+    extra_event.activity = "D";
+    extra_event.attributes["extra"] = "1";
+    extra.add_event(extra_event);
+    materialized->add_trace(extra);
+    materialized->columnarize_attributes();
+    EXPECT_NE(materialized->get_attribute_schema()->find_column("extra"), nullptr);
+    EXPECT_EQ(log->get_attribute_schema()->find_column("extra"), nullptr);
+    EXPECT_EQ(log->get_attribute_schema()->row_count(), 6);
+
+    EventLog plain;
+    EXPECT_THROW(plain.add_trace(log->get_traces()[0]), std::runtime_error);
+    plain.add_trace(log->get_traces()[0], schema.get());
+    const Event& expanded = plain.get_traces()[0].get_events()[1];
+    EXPECT_EQ(expanded.attribute_row, Event::no_attribute_row);
+    EXPECT_EQ(expanded.attributes.at("cost"), "150");
+    EXPECT_EQ(expanded.attributes.at("priority"), "medium");
+
+    TraceReservoir reservoir(4);
+    for (const auto& trace : log->get_traces()) {
+        reservoir.add(trace, schema.get());
+    }
+    auto sampled = reservoir.to_log();
+    EXPECT_EQ(sampled->get_traces()[1].get_events()[0].attributes.at("cost"), "120");
+
+    std::filesystem::remove(filepath);
+    std::filesystem::remove(filepath + ".columnar");
+    std::filesystem::remove(filepath + ".rows");
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include "procmine/log.h"
+#include "procmine/sampling.h"
+#include "test_logs.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+    using namespace procmine;
+    using namespace std::chrono;
+
+    EventLog create_test_log(size_t traces) {
+        return test::build_log(traces, [](size_t t) {
+            std::vector<std::string> activities = {"A", t % 10 == 0 ? "C" : "B", "D"};
+            if (t % 100 == 0) {
+                activities.push_back("E");
+            }
+            return activities;
+        }, [](size_t t, size_t, Event& event) { event.timestamp += seconds(t); });
+    }
+}
+
+TEST(SamplingTest, SamplingOperators) {
+    EventLog log = create_test_log(10000);
+    TraceSampler sampler(3);
+
+    auto reservoir = sampler.reservoir(log, 500);
+    EXPECT_EQ(reservoir.size(), 500);
+    EXPECT_EQ(sampler.reservoir(log, 500).get_trace(7).get_case_id(), reservoir.get_trace(7).get_case_id());
+
+    auto hashed = sampler.hash_by_case(log, 0.1);
+    EXPECT_NEAR(static_cast<double>(hashed.size()), 1000.0, 150.0);
+    for (const auto& trace : hashed) {
+        EXPECT_TRUE(sample_case(trace.get_case_id(), 0.1, 3));
+    }
+
+    auto stratified = sampler.stratified(log, 0.01);
+    EXPECT_EQ(stratified.size(), 90 + 9 + 1);
+    auto compact = stratified.materialize();
+    EXPECT_EQ(compact->get_traces().size(), stratified.size());
+
+    auto estimates = sampler.estimate_edge_frequencies(hashed, log.get_traces().size());
+    ASSERT_FALSE(estimates.empty());
+    EXPECT_EQ(estimates[0].from, "A");
+    for (const auto& estimate : estimates) {
+        double exact = estimate.from == "A" ? (estimate.to == "B" ? 9000.0 : 1000.0)
+                     : estimate.to == "D" ? (estimate.from == "B" ? 9000.0 : 1000.0)
+                     : 100.0;
+        EXPECT_NEAR(estimate.estimated_count, exact, 4.0 * estimate.standard_error + 1.0)
+            << estimate.from << "->" << estimate.to;
+    }
+
+    TraceReservoir stream(50, 9);
+    for (const auto& trace : log.get_traces()) {
+        stream.add(trace);
+    }
+    EXPECT_EQ(stream.seen(), 10000);
+    EXPECT_EQ(stream.to_log()->get_traces().size(), 50);
+
+    std::string csv_path = "sampling_test.csv";
+    {
+        std::ofstream file(csv_path);
+        file << "case_id,activity,timestamp\n";
+        for (int t = 0; t < 200; ++t) {
+            file << "case" << t << ",A,2024-01-01T10:00:00\n";
+            file << "case" << t << ",B,2024-01-01T10:05:00\n";
+        }
+    }
+    CSVLogReader reader(csv_path);
+    reader.set_case_sampling(0.25, 3);
+    auto sampled = reader.read();
+    std::filesystem::remove(csv_path);
+
+    size_t expected = 0;
+    for (int t = 0; t < 200; ++t) {
+        expected += sample_case("case" + std::to_string(t), 0.25, 3);
+    }
+    EXPECT_EQ(sampled->get_traces().size(), expected);
+    for (const auto& trace : sampled->get_traces()) {
+        EXPECT_EQ(trace.get_events().size(), 2);
+    }
+    EXPECT_THROW(reader.set_case_sampling(0.0), std::runtime_error);
+}
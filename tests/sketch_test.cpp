@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include "procmine/sketch.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace {
+    using namespace procmine;
+}
+
+TEST(SketchTest, TDigestQuantiles) {
+    std::mt19937_64 random(42);
+    std::exponential_distribution<double> distribution(0.01);
+
+    std::vector<double> values;
+    TDigest digest;
+    TDigest left;
+    TDigest right;
+    for (int i = 0; i < 100000; ++i) {
+        double value = distribution(random);
+        values.push_back(value);
+        digest.add(value);
+        (i % 2 == 0 ? left : right).add(value);
+    }
+    left.merge(right);
+    std::sort(values.begin(), values.end());
+
+    for (double q : {0.01, 0.5, 0.95, 0.99}) {
+        double exact = values[static_cast<size_t>(q * (values.size() - 1))];
+        EXPECT_NEAR(digest.quantile(q), exact, exact * 0.02) << "q=" << q;
+        EXPECT_NEAR(left.quantile(q), exact, exact * 0.02) << "q=" << q;
+    }
+
+    EXPECT_DOUBLE_EQ(left.count(), 100000.0);
+    EXPECT_DOUBLE_EQ(left.min(), values.front());
+    EXPECT_DOUBLE_EQ(left.max(), values.back());
+    EXPECT_LT(left.centroid_count(), 1000);
+    EXPECT_TRUE(std::isnan(TDigest().quantile(0.5)));
+    EXPECT_THROW(digest.quantile(1.5), std::runtime_error);
+}
+
+TEST(SketchTest, TDigestReservesLazily) {
+    TDigest digest;
+    EXPECT_EQ(digest.memory_usage(), sizeof(TDigest));
+
+    for (int i = 0; i < 10; ++i) {
+        digest.add(i);
+    }
+    EXPECT_EQ(digest.centroid_count(), 10);
+    double median = digest.quantile(0.5);
+    size_t compressed = digest.centroid_count();
+    EXPECT_LE(compressed, 10);
+    EXPECT_DOUBLE_EQ(digest.quantile(0.5), median);
+    EXPECT_EQ(digest.centroid_count(), compressed);
+}
+
+TEST(SketchTest, CountMinSketch) {
+    auto sketch = CountMinSketch::with_error(0.01, 0.01);
+    EXPECT_EQ(sketch.width(), 272);
+    EXPECT_EQ(sketch.depth(), 5);
+
+    CountMinSketch plain = sketch;
+    plain.set_conservative_update(false);
+    CountMinSketch left = sketch;
+    CountMinSketch right = sketch;
+
+    std::vector<uint64_t> exact(2000, 0);
+    std::mt19937_64 random(7);
+    std::uniform_int_distribution<uint64_t> pick(0, exact.size() - 1);
+    for (int i = 0; i < 50000; ++i) {
+        uint64_t key = i % 5 == 0 ? 3 : pick(random);
+        exact[key]++;
+        sketch.add(key);
+        plain.add(key);
+        (i % 2 == 0 ? left : right).add(key);
+    }
+    left.merge(right);
+
+    size_t within_bound = 0;
+    for (uint64_t key = 0; key < exact.size(); ++key) {
+        EXPECT_GE(sketch.estimate(key), exact[key]);
+        EXPECT_LE(sketch.estimate(key), plain.estimate(key));
+        EXPECT_GE(left.estimate(key), exact[key]);
+        if (sketch.estimate(key) - exact[key] <= sketch.error_bound()) {
+            within_bound++;
+        }
+    }
+    EXPECT_GE(within_bound, exact.size() * 99 / 100);
+    EXPECT_EQ(left.total(), 50000);
+
+    EXPECT_THROW(sketch.merge(CountMinSketch(10, 2)), std::runtime_error);
+    EXPECT_EQ(sketch_hash("A->B"), sketch_hash("A->B"));
+    EXPECT_NE(sketch_hash("A->B", 1), sketch_hash("A->B", 2));
+}
+
+TEST(SketchTest, HyperLogLog) {
+    HyperLogLog all;
+    HyperLogLog first;
+    HyperLogLog second;
+    for (int i = 0; i < 50000; ++i) {
+        std::string value = "case" + std::to_string(i);
+        all.add(value);
+        all.add(value);
+        (i < 30000 ? first : second).add(value);
+    }
+    first.merge(second);
+
+    EXPECT_NEAR(all.estimate(), 50000.0, 50000.0 * 0.05);
+    EXPECT_DOUBLE_EQ(first.estimate(), all.estimate());
+    EXPECT_LE(all.memory_usage(), 5000);
+
+    HyperLogLog small(10);
+    for (int i = 0; i < 10; ++i) {
+        small.add("resource" + std::to_string(i % 5));
+    }
+    EXPECT_NEAR(small.estimate(), 5.0, 0.1);
+    EXPECT_THROW(small.merge(all), std::runtime_error);
+    EXPECT_THROW(HyperLogLog(3), std::runtime_error);
+}
+
+TEST(SketchTest, SpaceSaving) {
+    SpaceSaving summary(50);
+    SpaceSaving left(50);
+    SpaceSaving right(50);
+    std::vector<uint64_t> exact(1000, 0);
+
+    std::mt19937_64 random(11);
+    std::uniform_int_distribution<uint64_t> tail(10, exact.size() - 1);
+    for (int i = 0; i < 20000; ++i) {
+        uint64_t key = i % 4 == 0 ? i % 3 : tail(random);
+        exact[key]++;
+        summary.add(key);
+        (i < 10000 ? left : right).add(key);
+    }
+    left.merge(right);
+
+    EXPECT_EQ(summary.size(), 50);
+    EXPECT_EQ(summary.total(), 20000);
+    EXPECT_EQ(left.total(), 20000);
+    for (const auto* sketch : {&summary, &left}) {
+        auto top = sketch->top(3);
+        ASSERT_EQ(top.size(), 3);
+        for (const auto& counter : top) {
+            EXPECT_LT(counter.key, 3);
+            EXPECT_GE(counter.count, exact[counter.key]);
+            EXPECT_LE(counter.count - counter.error, exact[counter.key]);
+            EXPECT_LE(counter.error, sketch->total() / 50 * 2);
+        }
+    }
+    EXPECT_GE(summary.estimate(999), exact[999]);
+}
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include "procmine/algorithm.h"
+#include "procmine/sketch.h"
+#include "procmine/summary.h"
+#include "test_logs.h"
+#include <chrono>
+#include <climits>
+#include <sstream>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+    using namespace procmine;
+    using namespace std::chrono;
+
+    EventLog create_test_log() {
+        std::vector<std::vector<std::string>> variants = {
+            {"A", "B", "C", "D"},
+            {"A", "C", "B", "D"},
+            {"A", "B", "D"},
+            {"A", "E", "E", "D"},
+            {"F"}
+        };
+        return test::build_log(300, [&](size_t t) { return variants[(t * 7) % variants.size()]; });
+    }
+
+    std::string read_all(int fd) {
+        std::string data;
+        char buffer[4096];
+        ssize_t count;
+        while ((count = ::read(fd, buffer, sizeof(buffer))) > 0) {
+            data.append(buffer, static_cast<size_t>(count));
+        }
+        return data;
+    }
+}
+
+TEST(SummaryTest, SerializationRoundTrip) {
+    EventLog log = create_test_log();
+    MiningSummary summary(log);
+
+    EXPECT_EQ(summary.trace_count(), 300);
+    EXPECT_EQ(summary.get_start_counts().at("A"), 240);
+    EXPECT_EQ(summary.get_end_counts().at("F"), 60);
+    EXPECT_EQ(summary.get_transition_counts().at({"E", "E"}), 60);
+
+    auto decoded = MiningSummary::deserialize(summary.serialize());
+    EXPECT_TRUE(decoded == summary);
+
+    std::stringstream stream;
+    summary.write(stream);
+    MiningSummary().write(stream);
+    EXPECT_TRUE(MiningSummary::read(stream) == summary);
+    EXPECT_EQ(MiningSummary::read(stream).trace_count(), 0);
+
+    std::string data = summary.serialize();
+    EXPECT_THROW(MiningSummary::deserialize(data.substr(0, data.size() - 1)), std::runtime_error);
+    EXPECT_THROW(MiningSummary::deserialize("XXXX"), std::runtime_error);
+
+    const std::string huge_count("\xff\xff\xff\xff\xff\xff\xff\xff\x7f", 9);
+    EXPECT_THROW(MiningSummary::deserialize("PMS1" + std::string(1, '\0') + huge_count), std::runtime_error);
+    EXPECT_THROW(MiningSummary::deserialize("PMS1" + std::string("\1\0\0\0\0\1", 6) + huge_count),
+                 std::runtime_error);
+
+    std::stringstream truncated(huge_count + "PMS1");
+    EXPECT_THROW(MiningSummary::read(truncated), std::runtime_error);
+}
+
+TEST(SummaryTest, ForkedShardMerge) {
+    EventLog log = create_test_log();
+    const int shards = 3;
+
+    std::vector<std::pair<pid_t, int>> workers;
+    for (int shard = 0; shard < shards; ++shard) {
+        int fds[2];
+        ASSERT_EQ(::pipe(fds), 0);
+        pid_t pid = ::fork();
+        ASSERT_GE(pid, 0);
+        if (pid == 0) {
+            ::close(fds[0]);
+            MiningSummary partial;
+            for (const auto& trace : log.get_traces()) {
+                if (sketch_hash(trace.get_case_id()) % shards == static_cast<uint64_t>(shard)) {
+                    partial.add_trace(trace);
+                }
+            }
+            std::string data = partial.serialize();
+            const char* cursor = data.data();
+            size_t remaining = data.size();
+            while (remaining > 0) {
+                ssize_t written = ::write(fds[1], cursor, remaining);
+                if (written <= 0) {
+                    ::_exit(1);
+                }
+                cursor += written;
+                remaining -= static_cast<size_t>(written);
+            }
+            ::close(fds[1]);
+            ::_exit(0);
+        }
+        ::close(fds[1]);
+        workers.emplace_back(pid, fds[0]);
+    }
+
+    MiningSummary merged;
+    for (const auto& [pid, fd] : workers) {
+        std::string data = read_all(fd);
+        ::close(fd);
+        int status = 0;
+        ASSERT_EQ(::waitpid(pid, &status, 0), pid);
+        ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+        merged.merge(MiningSummary::deserialize(data));
+    }
+
+    MiningSummary full(log);
+    EXPECT_TRUE(merged == full);
+
+    HeuristicMiner miner(0.5, 0.0);
+    EXPECT_EQ(miner.mine(merged)->to_dot(), miner.mine(log)->to_dot());
+
+    FrequencyAnalyzer analyzer;
+    auto sharded = analyzer.analyze(merged);
+    auto direct = analyzer.analyze(log);
+    EXPECT_EQ(sharded.activity_frequency, direct.activity_frequency);
+    EXPECT_EQ(sharded.transition_frequency, direct.transition_frequency);
+    EXPECT_EQ(sharded.variant_frequency, direct.variant_frequency);
+    EXPECT_EQ(sharded.variant_traces, direct.variant_traces);
+    EXPECT_EQ(analyzer.build_process_graph(sharded)->to_dot(),
+              analyzer.build_process_graph(direct)->to_dot());
+}
+
+TEST(SummaryTest, CountsBeyondIntRange) {
+    MiningSummary summary(create_test_log());
+    for (int i = 0; i < 26; ++i) {
+        MiningSummary copy = summary;
+        summary.merge(copy);
+    }
+    ASSERT_GT(summary.get_transition_counts().at({"A", "B"}), static_cast<uint64_t>(INT_MAX));
+
+    auto small = HeuristicMiner(0.5, 0.0).mine(MiningSummary(create_test_log()));
+    auto large = HeuristicMiner(0.5, 0.0).mine(summary);
+    ASSERT_EQ(large->node_count(), small->node_count());
+    for (Vertex v = 0; v < small->node_count(); ++v) {
+        for (const auto& edge : small->out_edges(v)) {
+            EXPECT_TRUE(large->has_edge(small->get_name(edge.from), small->get_name(edge.to)));
+        }
+    }
+    EXPECT_TRUE(large->has_edge(std::string_view("A"), std::string_view("B")));
+    EXPECT_TRUE(large->has_edge(std::string_view("E"), std::string_view("D")));
+
+    EXPECT_THROW(FrequencyAnalyzer().analyze(summary), std::runtime_error);
+}
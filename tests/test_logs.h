@@ -0,0 +1,40 @@
+#pragma once
+
+#include "procmine/models.h"
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace procmine::test {
+
+using TraceActivities = std::function<std::vector<std::string>(size_t trace)>;
+using EventSetup = std::function<void(size_t trace, size_t index, Event& event)>;
+
+inline EventLog build_log(size_t traces, const TraceActivities& activities,
+                          const EventSetup& setup = {},
+                          std::chrono::system_clock::time_point start = std::chrono::system_clock::now()) {
+    EventLog log;
+    for (size_t t = 0; t < traces; ++t) {
+        std::vector<std::string> names = activities(t);
+        Trace trace("case" + std::to_string(t));
+        trace.reserve(names.size());
+        for (size_t i = 0; i < names.size(); ++i) {
+            Event event;
+            event.activity = std::move(names[i]);
+            event.timestamp = start + std::chrono::seconds(i);
+            if (setup) {
+                setup(t, i, event);
+            }
+            trace.add_event(std::move(event));
+        }
+        log.add_trace(std::move(trace));
+    }
+    return log;
+}
+
+inline EventLog build_log(const std::vector<std::vector<std::string>>& variants) {
+    return build_log(variants.size(), [&](size_t t) { return variants[t]; });
+}
+
+}